@@ -0,0 +1,116 @@
+/**
+ * Project: gal
+ * @file color_kernels.cpp
+ * @date 17. 10. 2026
+ * @author xvitra00, xdocek09
+ * @brief Microbenchmark of the smallest unused color kernels.
+ */
+
+#include <algorithm>
+#include <chrono>
+#include <exception>
+#include <iomanip>
+#include <iostream>
+#include <string>
+#include <vector>
+
+#include "color_kernels.hpp"
+#include "graph.hpp"
+#include "graph_io.h"
+
+/**
+ * The original kernel: flags for all colors of the graph, scanned bit by bit
+ * and cleared with a second pass over the neighbors.
+ */
+class VectorBoolKernel {
+ public:
+  explicit VectorBoolKernel(size_t nodeCount) : flags_(nodeCount, false) {}
+
+  size_t smallestUnused(const Graph::Edges& neighbors,
+                        const Coloring& coloring) {
+    for (auto neighbor : neighbors) {
+      if (coloring.color(neighbor) != Coloring::NO_COLOR)
+        flags_[coloring.color(neighbor) - 1] = true;
+    }
+    size_t smallest = Coloring::NO_COLOR;
+    for (size_t i = 0; i < flags_.size(); ++i) {
+      if (!flags_[i]) {
+        smallest = Coloring::FIRST_COLOR + i;
+        break;
+      }
+    }
+    for (auto neighbor : neighbors) {
+      if (coloring.color(neighbor) != Coloring::NO_COLOR)
+        flags_[coloring.color(neighbor) - 1] = false;
+    }
+    return smallest;
+  }
+
+ private:
+  std::vector<bool> flags_;
+};
+
+inline constexpr size_t REPETITIONS = 5;
+
+/**
+ * Greedy coloring in the natural order with the kernel, the best of
+ * REPETITIONS runs in nanoseconds per node.
+ */
+template <typename Kernel>
+double sweep(const Graph& graph, Kernel& kernel, size_t& colorCount) {
+  using namespace std::chrono;
+  double best = 0.0;
+  Coloring coloring(graph.size());
+  for (size_t r = 0; r < REPETITIONS; ++r) {
+    coloring.clear();
+    auto begin = steady_clock::now();
+    for (size_t i = 0; i < graph.size(); ++i) {
+      coloring.color(i) = kernel.smallestUnused(graph.neighbors(i), coloring);
+    }
+    auto end = steady_clock::now();
+    double time = duration<double, std::nano>(end - begin).count();
+    best = r == 0 ? time : std::min(best, time);
+  }
+  colorCount =
+      *std::max_element(coloring.colors().begin(), coloring.colors().end());
+  return best / std::max<size_t>(1, graph.size());
+}
+
+void run(const std::string& name, const Graph& graph) {
+  std::cout << name << ": " << graph.size() << " nodes, "
+            << graph.edgeCount() / 2 << " edges\n";
+  auto report = [&](const char* kernelName, auto& kernel) {
+    size_t colors = 0;
+    double time = sweep(graph, kernel, colors);
+    std::cout << "  " << std::left << std::setw(12) << kernelName
+              << std::right << std::setw(10) << std::fixed
+              << std::setprecision(2) << time << " ns/node, " << colors
+              << " colors\n";
+  };
+  VectorBoolKernel vectorBool(graph.size());
+  report("vector<bool>", vectorBool);
+  BitsetColorKernel bitset;
+  report("bitset", bitset);
+  StampColorKernel stamp(graph.size());
+  report("stamp", stamp);
+}
+
+int main(int argc, char* argv[]) {
+  if (argc > 1) {
+    for (int i = 1; i < argc; ++i) {
+      try {
+        run(argv[i], loadGraph(argv[i]));
+      } catch (std::exception& e) {
+        std::cerr << argv[i] << ": " << e.what() << "\n";
+        return 1;
+      }
+    }
+    return 0;
+  }
+
+  run("G(1000000, 0.00001)", Graph(1000000, 0.00001));
+  run("G(100000, 0.001)", Graph(100000, 0.001));
+  run("G(5000, 0.5)", Graph(5000, 0.5));
+  return 0;
+}
+/*** End of file: color_kernels.cpp ***/
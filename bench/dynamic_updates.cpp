@@ -0,0 +1,141 @@
+/**
+ * Project: gal
+ * @file dynamic_updates.cpp
+ * @date 17. 10. 2026
+ * @author xvitra00, xdocek09
+ * @brief Replays update batches on a dynamic coloring and validates it.
+ */
+
+#include <algorithm>
+#include <chrono>
+#include <exception>
+#include <iomanip>
+#include <iostream>
+#include <string>
+#include <vector>
+
+#include <random.h>
+#include "coloring_alg.h"
+#include "dynamic_coloring.h"
+#include "graph.hpp"
+#include "graph_io.h"
+
+inline constexpr size_t BATCHES = 10;
+inline constexpr size_t BATCH_SIZE = 10000;
+
+/**
+ * A batch of random updates of the current graph: mostly edge insertions and
+ * removals, with a few node additions and removals.
+ */
+std::vector<DynamicColoring::Update> randomBatch(const DynamicColoring& dc,
+                                                 GalRandom& random) {
+  using Update = DynamicColoring::Update;
+  std::vector<Update> batch;
+  auto aliveNode = [&] {
+    size_t node;
+    do {
+      node = random.uniform(dc.size());
+    } while (!dc.contains(node));
+    return node;
+  };
+  // removed nodes are not reused within the batch, they are still holes
+  std::vector<bool> removed(dc.size(), false);
+  while (batch.size() < BATCH_SIZE) {
+    size_t kind = random.uniform(20);
+    size_t a = aliveNode();
+    if (removed[a]) {
+      continue;
+    }
+    if (kind == 0) {
+      batch.push_back({Update::ADD_NODE});
+    } else if (kind == 1) {
+      removed[a] = true;
+      batch.push_back({Update::REMOVE_NODE, a});
+    } else if (kind < 11) {
+      size_t b = aliveNode();
+      if (!removed[b]) {
+        batch.push_back({Update::INSERT_EDGE, a, b});
+      }
+    } else if (!dc.neighbors(a).empty()) {
+      auto&& edges = dc.neighbors(a);
+      size_t b = edges.begin()[random.uniform(edges.size())];
+      if (!removed[b]) {
+        batch.push_back({Update::REMOVE_EDGE, a, b});
+      }
+    }
+  }
+  return batch;
+}
+
+/**
+ * Applies BATCHES batches and compares the time with greedy coloring of the
+ * updated graph from scratch. False when a coloring is not valid.
+ */
+bool run(const std::string& name, const Graph& graph) {
+  using namespace std::chrono;
+  std::cout << name << ": " << graph.size() << " nodes, "
+            << graph.edgeCount() / 2 << " edges\n";
+
+  // a coloring with every edge in conflict has to be repaired on the way in
+  Coloring conflicting(graph.size());
+  for (size_t i = 0; i < graph.size(); ++i) {
+    conflicting.color(i) = Coloring::FIRST_COLOR;
+  }
+  if (!DynamicColoring(graph, conflicting).graph().validateColors()) {
+    std::cerr << "error: conflicts not repaired.\n";
+    return false;
+  }
+
+  Coloring coloring(graph.size());
+  greedyColoring(graph, coloring);
+  DynamicColoring dc(graph, coloring);
+  GalRandom random(2018);
+  for (size_t i = 0; i < BATCHES; ++i) {
+    auto batch = randomBatch(dc, random);
+    auto begin = steady_clock::now();
+    dc.apply(batch);
+    auto end = steady_clock::now();
+
+    ColoredGraph updated = dc.graph();
+    if (!updated.validateColors()) {
+      std::cerr << "error: coloring not valid after batch " << i << ".\n";
+      return false;
+    }
+    Coloring fresh(updated.size());
+    auto freshBegin = steady_clock::now();
+    greedyColoring(updated.graph(), fresh);
+    auto freshEnd = steady_clock::now();
+    std::cout << "  batch " << std::setw(2) << i << std::fixed
+              << std::setprecision(3) << std::setw(10)
+              << duration<double, std::milli>(end - begin).count()
+              << " ms, " << dc.colorCount() << " colors; from scratch"
+              << std::setw(10)
+              << duration<double, std::milli>(freshEnd - freshBegin).count()
+              << " ms, " << fresh.colorCount() << " colors\n";
+  }
+  return true;
+}
+
+int main(int argc, char* argv[]) {
+  gal_seed(2018);
+  if (argc > 1) {
+    for (int i = 1; i < argc; ++i) {
+      try {
+        if (!run(argv[i], loadGraph(argv[i]))) {
+          return 1;
+        }
+      } catch (std::exception& e) {
+        std::cerr << argv[i] << ": " << e.what() << "\n";
+        return 1;
+      }
+    }
+    return 0;
+  }
+
+  if (!run("G(100000, 0.0001)", Graph(100000, 0.0001)) ||
+      !run("G(5000, 0.05)", Graph(5000, 0.05))) {
+    return 1;
+  }
+  return 0;
+}
+/*** End of file: dynamic_updates.cpp ***/
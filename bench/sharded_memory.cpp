@@ -0,0 +1,177 @@
+/**
+ * Project: gal
+ * @file sharded_memory.cpp
+ * @date 17. 10. 2026
+ * @author xvitra00, xdocek09
+ * @brief Peak memory of sharded coloring from memory and from a snapshot.
+ */
+
+#include <sys/resource.h>
+#include <sys/wait.h>
+#include <unistd.h>
+
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <exception>
+#include <iostream>
+#include <string>
+#include <vector>
+
+#include <random.h>
+#include "graph.hpp"
+#include "graph_io.h"
+#include "sharded_coloring.h"
+
+inline constexpr unsigned WORKERS = 4;
+
+/**
+ * What a measured run reports: peak resident set sizes in KiB of the
+ * coordinator and of its largest worker, the time and the rounds. The colors
+ * follow it through the pipe.
+ */
+struct Measurement {
+  long coordinatorPeak;
+  long workerPeak;
+  double milliseconds;
+  size_t rounds;
+};
+
+/**
+ * Runs f(coloring) in a child process, so the peaks are of this run only and
+ * nothing is left in this process.
+ *
+ * @return False when the child fails.
+ */
+template <typename F>
+bool measure(size_t n, F&& f, Measurement& measurement, Coloring& coloring) {
+  int fds[2];
+  if (::pipe(fds) != 0) {
+    return false;
+  }
+  pid_t pid = ::fork();
+  if (pid < 0) {
+    ::close(fds[0]);
+    ::close(fds[1]);
+    return false;
+  }
+  if (pid == 0) {
+    ::close(fds[0]);
+    int status = 0;
+    try {
+      using namespace std::chrono;
+      Coloring result(n);
+      auto begin = steady_clock::now();
+      size_t rounds = f(result);
+      auto end = steady_clock::now();
+      struct rusage self;
+      struct rusage children;
+      ::getrusage(RUSAGE_SELF, &self);
+      ::getrusage(RUSAGE_CHILDREN, &children);
+      Measurement m{self.ru_maxrss, children.ru_maxrss,
+                    duration<double, std::milli>(end - begin).count(),
+                    rounds};
+      FILE* out = ::fdopen(fds[1], "wb");
+      bool written =
+          out != nullptr && std::fwrite(&m, sizeof(m), 1, out) == 1 &&
+          std::fwrite(result.colors().data(), sizeof(size_t), n, out) == n;
+      status = written && std::fclose(out) == 0 ? 0 : 1;
+    } catch (std::exception& e) {
+      std::cerr << e.what() << "\n";
+      status = 1;
+    }
+    ::_exit(status);
+  }
+  ::close(fds[1]);
+  FILE* in = ::fdopen(fds[0], "rb");
+  bool read = in != nullptr &&
+              std::fread(&measurement, sizeof(measurement), 1, in) == 1;
+  for (size_t i = 0; read && i < n; ++i) {
+    read = std::fread(&coloring.color(i), sizeof(size_t), 1, in) == 1;
+  }
+  if (in != nullptr) {
+    std::fclose(in);
+  }
+  int status = 0;
+  return ::waitpid(pid, &status, 0) == pid && WIFEXITED(status) &&
+         WEXITSTATUS(status) == 0 && read;
+}
+
+void report(const char* name,
+            const Measurement& m,
+            const Graph& graph,
+            Coloring& coloring) {
+  coloring.colorCount() = 0;
+  for (size_t i = 0; i < coloring.size(); ++i) {
+    coloring.colorCount() = std::max(coloring.colorCount(), coloring.color(i));
+  }
+  std::cout << "  " << name << ": coordinator peak "
+            << m.coordinatorPeak / 1024 << " MiB, largest worker peak "
+            << m.workerPeak / 1024 << " MiB, " << m.milliseconds << " ms, "
+            << coloring.colorCount() << " colors, " << m.rounds << " rounds, "
+            << (coloring.validate(graph) ? "valid" : "NOT VALID") << "\n";
+}
+
+/**
+ * Colors a snapshot once straight from the file and once loaded into memory
+ * and compares the peak memory of the processes.
+ */
+int main(int argc, char* argv[]) {
+  if (argc > 2) {
+    std::cerr << "usage: ./sharded_memory [snapshot.bin]\n";
+    return 1;
+  }
+  std::string filename = argc == 2 ? argv[1] : "sharded_memory.bin";
+  try {
+    if (argc == 1) {
+      gal_seed(2018);
+      saveSnapshot(Graph(200000, 0.0005), filename);
+    }
+    Graph graph = loadGraph(filename);
+    const size_t n = graph.size();
+    std::cout << filename << ": " << n << " nodes, "
+              << graph.edgeCount() / 2 << " edges, " << WORKERS
+              << " workers\n";
+
+    Measurement m;
+    Coloring coloring(n);
+    bool ok = measure(
+        n,
+        [&](Coloring& result) {
+          return shardedColoring(filename, result, WORKERS).rounds;
+        },
+        m, coloring);
+    if (ok) {
+      report("snapshot", m, graph, coloring);
+    }
+    ok = ok && measure(
+                   n,
+                   [&](Coloring& result) {
+                     // a fresh copy, as if it was loaded by this process
+                     Graph copy(std::vector<size_t>(graph.offsets().begin(),
+                                                    graph.offsets().end()),
+                                std::vector<size_t>(
+                                    graph.adjacency().begin(),
+                                    graph.adjacency().end()));
+                     return shardedColoring(copy, result, WORKERS,
+                                            ShardPartition::RANGES)
+                         .rounds;
+                   },
+                   m, coloring);
+    if (ok) {
+      report("memory", m, graph, coloring);
+    }
+    if (argc == 1) {
+      std::remove(filename.c_str());
+    }
+    if (!ok) {
+      std::cerr << "error: a measured run failed.\n";
+      return 1;
+    }
+    return 0;
+  } catch (std::exception& e) {
+    std::cerr << filename << ": " << e.what() << "\n";
+    return 1;
+  }
+}
+/*** End of file: sharded_memory.cpp ***/
@@ -0,0 +1,110 @@
+/**
+ * Project: gal
+ * @file snapshot_check.cpp
+ * @date 17. 10. 2026
+ * @author xvitra00, xdocek09
+ * @brief Loads corrupted snapshots with several threads and expects errors.
+ */
+
+#include <cstdio>
+#include <cstring>
+#include <exception>
+#include <fstream>
+#include <iostream>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+#include "graph.hpp"
+#include "graph_io.h"
+
+inline constexpr unsigned THREADS = 2;
+
+/**
+ * Writes a snapshot with the given offsets and adjacency as they are, with a
+ * header that is valid for them.
+ */
+void writeSnapshot(const std::string& filename,
+                   const std::vector<uint64_t>& offsets,
+                   const std::vector<uint64_t>& adjacency) {
+  SnapshotHeader header{};
+  std::memcpy(header.magic, "GALCSR\0\0", sizeof(header.magic));
+  header.version = SNAPSHOT_VERSION;
+  header.byteOrder = 0x01020304;
+  header.nodeCount = offsets.size() - 1;
+  header.edgeCount = adjacency.size();
+  std::ofstream out(filename, std::ios::binary);
+  out.write(reinterpret_cast<const char*>(&header), sizeof(header));
+  out.write(reinterpret_cast<const char*>(offsets.data()),
+            offsets.size() * sizeof(uint64_t));
+  out.write(reinterpret_cast<const char*>(adjacency.data()),
+            adjacency.size() * sizeof(uint64_t));
+  if (!out) {
+    throw std::runtime_error("Can not write " + filename + ".");
+  }
+}
+
+/**
+ * True when the snapshot is rejected by both loadSnapshot with THREADS threads
+ * and loadGraph.
+ */
+bool rejected(const std::string& filename) {
+  size_t errors = 0;
+  try {
+    loadSnapshot(filename, true, THREADS);
+  } catch (std::invalid_argument&) {
+    ++errors;
+  }
+  try {
+    loadGraph(filename, THREADS);
+  } catch (std::invalid_argument&) {
+    ++errors;
+  }
+  return errors == 2;
+}
+
+/**
+ * Each case is loaded with more than one thread, so the blocks of the check
+ * meet at a corrupted offset.
+ */
+int main() {
+  const std::string filename = "snapshot_check.bin";
+  struct Case {
+    const char* name;
+    std::vector<uint64_t> offsets;
+    std::vector<uint64_t> adjacency;
+    bool valid;
+  };
+  const std::vector<Case> cases = {
+      {"valid", {0, 1, 2}, {1, 0}, true},
+      {"offset far past the end", {0, uint64_t{1} << 40, 2}, {1, 0}, false},
+      {"decreasing offsets", {0, 2, 1, 3}, {1, 0, 1}, false},
+      {"edge to a missing node", {0, 1, 2}, {1, 2}, false},
+  };
+  bool ok = true;
+  for (auto&& c : cases) {
+    try {
+      writeSnapshot(filename, c.offsets, c.adjacency);
+      bool good;
+      if (c.valid) {
+        Graph graph = loadSnapshot(filename, true, THREADS);
+        good = graph.size() == c.offsets.size() - 1 &&
+               graph.edgeCount() == c.adjacency.size();
+      } else {
+        good = rejected(filename);
+      }
+      std::cout << "  " << c.name << ": " << (good ? "ok" : "FAILED") << "\n";
+      ok = ok && good;
+    } catch (std::exception& e) {
+      std::cerr << c.name << ": " << e.what() << "\n";
+      ok = false;
+    }
+  }
+  std::remove(filename.c_str());
+  if (!ok) {
+    std::cerr << "error: a snapshot was not checked as expected.\n";
+    return 1;
+  }
+  return 0;
+}
+/*** End of file: snapshot_check.cpp ***/
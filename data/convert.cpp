@@ -0,0 +1,30 @@
+/**
+ * Project: gal
+ * @file convert.cpp
+ * @date 17. 10. 2026
+ * @author xvitra00, xdocek09
+ * @brief Convert text graphs to binary snapshots.
+ */
+
+#include <exception>
+#include <iostream>
+
+#include "graph.hpp"
+#include "graph_io.h"
+
+int main(int argc, char* argv[]) {
+	if (argc != 3) {
+		std::cerr << "usage: ./convert input.txt output.bin\n";
+		return 1;
+	}
+
+	try {
+		Graph graph = loadGraph(argv[1]);
+		saveSnapshot(graph, argv[2]);
+	} catch (std::exception& e) {
+		std::cerr << e.what() << "\n";
+		return 1;
+	}
+
+	return 0;
+}
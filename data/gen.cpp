@@ -6,55 +6,43 @@
  * @brief Generate test data.
  */
 
+#include <algorithm>
+#include <cmath>
 #include <iostream>
 #include <fstream>
 #include <string>
-#include <cassert>
+#include <vector>
 
-#include "coloring_alg.h"
-#include "graph.hpp"
+#include <random.h>
+#include "generators.h"
 
-void insertMissingEdges(ColoredGraph& g, size_t edges) {
-	size_t edgeCount = g.edgeCount();
-	while (edgeCount < edges) {
-		// try to add to a random node
-		size_t selected = gal_rand(g.size());
-		auto&& node = g[selected];
-		// cannot add an edge
-		if (node.edges().size() == g.size() - 1) {
-			continue;
-		}
-		auto it = node.edges().begin();
-		// find a missing edge and insert it
-		size_t e = 0;
-		for (; it != node.edges().end(); ++it, ++e) {
-			if (e == selected) {
-				++e;
-			}
-			if (*it != e) {
-				// insert new edge
-				if (g.insertEdge(selected, e)) {
-					edgeCount += 2;
-				}
-				goto insertNext;
-			}
-		}
-		// empty or at the end
-		if (g.insertEdge(selected, e)) {
-			edgeCount += 2;
-		}
-	insertNext:;
-	}
+void usage() {
+	std::cerr << "usage: ./gen [--model gnm|rmat|ba|geo] [--seed seed] "
+	             "nodeCount edgeCount outputName\n";
 }
 
 int main(int argc, char* argv[]) {
-	if (argc != 4) {
-		std::cerr << "usage: ./gen nodeCount edgeCount outputName\n";
+	std::string model = "gnm";
+	std::vector<std::string> args;
+	for (int i = 1; i < argc; ++i) {
+		std::string arg = argv[i];
+		if ((arg == "--model" || arg == "--seed") && i + 1 < argc) {
+			if (arg == "--model") {
+				model = argv[++i];
+			} else {
+				gal_seed(std::stoull(argv[++i]));
+			}
+		} else {
+			args.push_back(arg);
+		}
+	}
+	if (args.size() != 3) {
+		usage();
 		return 1;
 	}
 
-	size_t nodeCount = std::stoul(argv[1]);
-	size_t edgeCount = std::stoul(argv[2]);
+	size_t nodeCount = std::stoul(args[0]);
+	size_t edgeCount = std::stoul(args[1]);
 
 	if (nodeCount < 1) {
 		std::cerr << "There must be at least one node in the generated graph.\n";
@@ -64,19 +52,32 @@ int main(int argc, char* argv[]) {
 		std::cerr << "edgeCount * 2 must be at most nodeCount * (nodeCount - 1)\n";
 		return 1;
 	}
-	double edgePropability = static_cast<double>(edgeCount) / (nodeCount * (nodeCount - 1));
-
-	ColoredGraph generated(nodeCount, edgePropability, edgeCount);
-	// add edges if missing
-	insertMissingEdges(generated, edgeCount * 2);
-	assert(generated.edgeCount() == edgeCount * 2);
 
-	std::ofstream of(argv[3]);
+	std::ofstream of(args[2]);
+	if (!of) {
+		std::cerr << "Could not open output file " << args[2] << ".\n";
+		return 1;
+	}
+	if (model == "gnm") {
+		writeGnm(of, nodeCount, edgeCount);
+	} else if (model == "rmat") {
+		writeRmat(of, nodeCount, edgeCount);
+	} else if (model == "ba") {
+		size_t edgesPerNode = std::max<size_t>(1, (edgeCount + nodeCount / 2) / nodeCount);
+		writeBarabasiAlbert(of, nodeCount, edgesPerNode);
+	} else if (model == "geo") {
+		// expected number of pairs closer than r, boundary effects aside
+		const double pi = std::acos(-1.0);
+		double radius = std::sqrt(2.0 * edgeCount / (pi * nodeCount * (nodeCount - 1.0)));
+		writeGeometric(of, nodeCount, std::max(radius, 1e-9));
+	} else {
+		usage();
+		return 1;
+	}
 	if (!of) {
-		std::cerr << "Could not open output file " << argv[3] << ".\n";
+		std::cerr << "Could not write output file " << args[2] << ".\n";
 		return 1;
 	}
-	generated.print(of);
 
 	return 0;
-}
\ No newline at end of file
+}
@@ -13,90 +13,181 @@
 #ifndef SRC_COLORING_ALG_HPP_
 #define SRC_COLORING_ALG_HPP_
 
+#include <chrono>
 #include <vector>
 #include "graph.hpp"
 
 inline constexpr size_t ALGORITHM_COUNT = 4;
 
+// The algorithms only read the graph and write its colors to a coloring of
+// graph.size() uncolored nodes, e.g. Coloring(graph.size()) or a cleared one.
+
 /**
  * Is greedy coloring algorithm with adjustable node permutation.
  * Source: http://www.new-npac.org/users/fox/pdftotal/sccs-0666.pdf
  *
- * @param[in|out] graph you want to color.
+ * @param[in] graph you want to color.
+ * @param[out] coloring	The colors of the graph.
  * @param[in] nodesPermut	Permutation that defines order of nodes. Ordered
  * sequence of nodes ids.
  */
-void greedyColoring(ColoredGraph& graph, const std::vector<size_t> nodesPermut);
+void greedyColoring(const Graph& graph,
+                    Coloring& coloring,
+                    const std::vector<size_t> nodesPermut);
 
 /**
  * Color the graph with greedy coloring algorithm.
  *
  *
- * @param[in|out] graph you want to color.
+ * @param[in] graph you want to color.
+ * @param[out] coloring	The colors of the graph.
  */
-void greedyColoring(ColoredGraph& graph);
+void greedyColoring(const Graph& graph, Coloring& coloring);
 
 /**
  * Color the graph with greedy coloring algorithm.
  *
- * @param[in|out] graph you want to color.
+ * @param[in] graph you want to color.
+ * @param[out] coloring	The colors of the graph.
  */
-void greedyColoringWithSet(ColoredGraph& graph);
+void greedyColoringWithSet(const Graph& graph, Coloring& coloring);
 
 /**
  * Color the graph with largest Degree Ordering algorithm.
  *
  * Source: http://dergipark.gov.tr/download/article-file/254140
  *
- * @param[in|out] graph you want to color.
+ * @param[in] graph you want to color.
+ * @param[out] coloring	The colors of the graph.
+ */
+void largestDegreeOrderingColoring(const Graph& graph, Coloring& coloring);
+
+/**
+ * Computes the smallest-last (degeneracy) ordering: nodes of the smallest
+ * remaining degree are removed from the graph one by one and the ordering is
+ * the reverse of the removals. Uses a bucket queue, O(n + m).
+ *
+ * Source: Matula, Beck: Smallest-last ordering and clustering and graph
+ * coloring algorithms, 1983.
+ *
+ * @param[in] graph	The graph.
+ * @param[out] degeneracy	The largest degree a node had when it was removed,
+ * greedy coloring in this order uses at most degeneracy + 1 colors.
+ * @return Ordered sequence of node ids.
  */
-void largestDegreeOrderingColoring(ColoredGraph& graph);
+std::vector<size_t> smallestLastOrdering(const Graph& graph,
+                                         size_t& degeneracy);
+
+/**
+ * The degeneracy of the graph, see smallestLastOrdering().
+ */
+size_t degeneracy(const Graph& graph);
+
+/**
+ * Color the graph with greedy coloring in the smallest-last ordering.
+ *
+ * @param[in] graph you want to color.
+ * @param[out] coloring	The colors of the graph.
+ */
+void smallestLastColoring(const Graph& graph, Coloring& coloring);
 
 /**
  * Color the graph with Incidence Degree Ordering algorithm.
+ * The next node is always one with the most colored neighbors, ties are
+ * broken by the largest degree. Uses bucket queues, O(n + m).
  *
  * Source: http://dergipark.gov.tr/download/article-file/254140
  *
- * @param[in|out] graph you want to color.
+ * @param[in] graph you want to color.
+ * @param[out] coloring	The colors of the graph.
  */
-void incidenceDegreeOrdering(ColoredGraph& graph);
+void incidenceDegreeOrdering(const Graph& graph, Coloring& coloring);
 
 /**
- * Color the graph using SDO and LDO heuristics
+ * Color the graph using SDO and LDO heuristics (DSatur): the next node is
+ * the one with the most distinct colors among its neighbors, ties are broken
+ * by the largest degree. Neighbor colors are kept in per node bitsets and
+ * the nodes in the same bucket queues as in incidence degree ordering,
+ * O(n + m).
  *
  * Source: http://www.phys.ubbcluj.ro/~zneda/edu/mc/graphcolouring.pdf
  */
-void sdoLdoColoring(ColoredGraph& graph);
+void sdoLdoColoring(const Graph& graph, Coloring& coloring);
+
+/**
+ * Improves an existing valid coloring with iterated greedy (Culberson:
+ * Iterated greedy graph coloring and the difficulty landscape). Every
+ * iteration puts the color classes into a new order, one after another
+ * reversed, largest first and random, and colors the nodes greedily class by
+ * class. A node never gets a color above the position of its class, so the
+ * number of colors never grows.
+ *
+ * Random orders come from gal_thread_random().
+ *
+ * @param[in] graph The colored graph.
+ * @param[in|out] coloring	A valid coloring of the graph.
+ * @param[in] maxIterations	The iteration budget.
+ * @param[in] timeLimit	The wall-clock budget, checked after each iteration.
+ * @return The number of iterations done.
+ */
+size_t iteratedGreedy(const Graph& graph,
+                      Coloring& coloring,
+                      size_t maxIterations,
+                      std::chrono::steady_clock::duration timeLimit =
+                          std::chrono::steady_clock::duration::max());
 
 class GreedyColoring {
  public:
-  static void color(ColoredGraph& graph) { return greedyColoring(graph); }
+  static void color(const Graph& graph, Coloring& coloring) {
+    return greedyColoring(graph, coloring);
+  }
 };
 
 class GreedyColoringWithSet {
  public:
-  static void color(ColoredGraph& graph) {
-    return greedyColoringWithSet(graph);
+  static void color(const Graph& graph, Coloring& coloring) {
+    return greedyColoringWithSet(graph, coloring);
   }
 };
 
 class LargestDegreeOrderingColoring {
  public:
-  static void color(ColoredGraph& graph) {
-    return largestDegreeOrderingColoring(graph);
+  static void color(const Graph& graph, Coloring& coloring) {
+    return largestDegreeOrderingColoring(graph, coloring);
+  }
+};
+
+class SmallestLastColoring {
+ public:
+  static void color(const Graph& graph, Coloring& coloring) {
+    return smallestLastColoring(graph, coloring);
+  }
+};
+
+/**
+ * Greedy coloring improved by at most 100 iterations of iterated greedy
+ * within one second.
+ */
+class IteratedGreedyColoring {
+ public:
+  static void color(const Graph& graph, Coloring& coloring) {
+    greedyColoring(graph, coloring);
+    iteratedGreedy(graph, coloring, 100, std::chrono::seconds(1));
   }
 };
 
 class IncidenceDegreeColoring {
  public:
-  static void color(ColoredGraph& graph) {
-    return incidenceDegreeOrdering(graph);
+  static void color(const Graph& graph, Coloring& coloring) {
+    return incidenceDegreeOrdering(graph, coloring);
   }
 };
 
 class SdoLdoColoring {
  public:
-  static void color(ColoredGraph& graph) { return sdoLdoColoring(graph); }
+  static void color(const Graph& graph, Coloring& coloring) {
+    return sdoLdoColoring(graph, coloring);
+  }
 };
 
 #endif /* SRC_COLORING_ALG_HPP_ */
@@ -0,0 +1,151 @@
+/**
+ * Project: gal
+ * @file dynamic_coloring.h
+ * @date 17. 10. 2026
+ * @author xvitra00, xdocek09
+ * @brief Header file of module maintaining a coloring of a changing graph.
+ */
+
+#ifndef GAL_DYNAMIC_COLORING_H
+#define GAL_DYNAMIC_COLORING_H
+
+#include <cstddef>
+#include <vector>
+
+#include "color_kernels.hpp"
+#include "graph.hpp"
+
+/**
+ * A graph with a valid coloring that is kept valid under edge and node
+ * insertions and removals.
+ *
+ * The CSR arrays of Graph would have to be rebuilt on every change, so
+ * the graph is copied to one edge list per node. An inserted edge whose
+ * endpoints share a color recolors one of them with the smallest color free
+ * among its neighbors; nothing else is touched. With local recoloring
+ * enabled, the endpoints of removed edges and the neighbors of removed nodes
+ * move to a smaller free color when there is one, which gives colors back
+ * once the highest color class empties. Every update costs time proportional
+ * to the degrees of the nodes it touches, never to the size of the graph.
+ *
+ * Node ids are stable: removed nodes leave a hole that addNode() reuses.
+ */
+class DynamicColoring {
+ public:
+  /**
+   * A change of the graph for apply().
+   */
+  struct Update {
+    enum Type { INSERT_EDGE, REMOVE_EDGE, ADD_NODE, REMOVE_NODE };
+
+    Type type;
+    // the edge, or the node in a for REMOVE_NODE; unused for ADD_NODE
+    size_t a = 0;
+    size_t b = 0;
+  };
+
+  /**
+   * Copies the graph and its coloring. Uncolored nodes and nodes that share
+   * a color with a neighbor are colored greedily, once, in the order of ids.
+   *
+   * @param[in] graph	The graph.
+   * @param[in] coloring	Coloring of the graph, possibly partial or invalid.
+   * @param[in] localRecoloring	Move touched nodes to smaller free colors.
+   * @throw std::invalid_argument When the coloring does not match the graph
+   * or has a color above the number of nodes.
+   */
+  DynamicColoring(const Graph& graph,
+                  const Coloring& coloring,
+                  bool localRecoloring = true);
+
+  /**
+   * Inserts an undirected edge, loops and existing edges are ignored.
+   *
+   * @throw std::invalid_argument When a node does not exist.
+   */
+  void insertEdge(size_t a, size_t b);
+
+  /**
+   * Removes an undirected edge if it exists.
+   *
+   * @throw std::invalid_argument When a node does not exist.
+   */
+  void removeEdge(size_t a, size_t b);
+
+  /**
+   * Adds an isolated node with the first color.
+   *
+   * @return Id of the new node.
+   */
+  size_t addNode();
+
+  /**
+   * Removes a node with all of its edges.
+   *
+   * @throw std::invalid_argument When the node does not exist.
+   */
+  void removeNode(size_t node);
+
+  /**
+   * Applies a batch of updates. The structure is changed first and only then
+   * are the conflicting nodes recolored, each of them once, largest degree
+   * first. Node ids created by ADD_NODE are returned in order.
+   *
+   * @throw std::invalid_argument When an update refers to a missing node.
+   */
+  std::vector<size_t> apply(const std::vector<Update>& updates);
+
+  /**
+   * The number of node ids, including the removed ones.
+   */
+  size_t size() const noexcept { return adjacency_.size(); }
+
+  bool contains(size_t node) const noexcept {
+    return node < size() && alive_[node];
+  }
+
+  size_t color(size_t node) const noexcept { return colors_[node]; }
+
+  /**
+   * The highest color in use.
+   */
+  size_t colorCount() const noexcept { return classSize_.size() - 1; }
+
+  Graph::Edges neighbors(size_t node) const noexcept {
+    auto&& edges = adjacency_[node];
+    return {edges.data(), edges.data() + edges.size()};
+  }
+
+  bool hasEdge(size_t a, size_t b) const;
+
+  /**
+   * Builds a ColoredGraph with the current edges and coloring. Removed nodes
+   * stay as isolated nodes with the first color, so the ids do not change.
+   */
+  ColoredGraph graph() const;
+
+ private:
+  void checkNode(size_t node) const;
+  bool link(size_t a, size_t b);
+  bool unlink(size_t a, size_t b);
+  void setColor(size_t node, size_t color);
+  // the smallest color unused by the neighbors
+  size_t freeColor(size_t node);
+  // recolors a node that conflicts with a neighbor
+  void repair(size_t node);
+  // moves a node to a smaller free color if there is one
+  void lower(size_t node);
+  void removeNodeEdges(size_t node, std::vector<size_t>& touched);
+
+  std::vector<std::vector<size_t>> adjacency_;
+  std::vector<size_t> colors_;
+  std::vector<bool> alive_;
+  std::vector<size_t> freeIds_;
+  // the number of nodes of each color, the last one is never 0
+  std::vector<size_t> classSize_;
+  StampColorKernel kernel_;
+  bool localRecoloring_;
+};
+
+#endif
+/*** End of file: dynamic_coloring.h ***/
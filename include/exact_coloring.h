@@ -0,0 +1,84 @@
+/**
+ * Project: gal
+ * @file exact_coloring.h
+ * @date 17. 10. 2026
+ * @author xvitra00, xdocek09
+ * @brief Header file of module computing optimal colorings of small graphs.
+ */
+
+#ifndef GAL_EXACT_COLORING_H
+#define GAL_EXACT_COLORING_H
+
+#include <chrono>
+#include <cstddef>
+#include <limits>
+
+#include "graph.hpp"
+
+/**
+ * Outcome of exactColoring().
+ */
+struct ExactColoringResult {
+  // the number of colors of the best coloring found
+  size_t colorCount = 0;
+  // the chromatic number is at least this
+  size_t lowerBound = 0;
+  // the search finished, colorCount is the chromatic number
+  bool optimal = false;
+  // the number of search tree nodes visited
+  size_t searchNodes = 0;
+};
+
+/**
+ * Colors the graph with the smallest possible number of colors using DSatur
+ * branch and bound (Brélaz: New methods to color the vertices of a graph;
+ * San Segundo: A new DSATUR-based algorithm for exact vertex coloring).
+ *
+ * The adjacency is kept as one bitset row per node and the search state as
+ * bitsets too: the uncolored nodes and, for every color, the nodes that may
+ * no longer take it. Coloring a node is a few word operations over its row,
+ * and saturation degrees are updated only for the neighbors that newly lose
+ * a color.
+ *
+ * A greedy clique gives the lower bound and is precolored, which also breaks
+ * the color symmetry. The best of the DSatur and smallest-last colorings,
+ * improved by iterated greedy, gives the first upper bound. The search then
+ * branches on the node with the most distinct neighbor colors, the most
+ * uncolored neighbors on ties, and tries only colorings with fewer colors
+ * than the best one found so far.
+ *
+ * The bitset rows take n * n / 8 bytes, so the solver is meant for graphs of
+ * at most a few thousand nodes.
+ *
+ * @param[in] graph	The graph.
+ * @param[out] coloring	It gets the best coloring found.
+ * @param[in] nodeLimit	The number of search tree nodes to visit at most.
+ * @param[in] timeLimit	The wall-clock budget of the search.
+ * @return The bounds found, optimal is false when a limit was hit.
+ */
+ExactColoringResult exactColoring(
+    const Graph& graph,
+    Coloring& coloring,
+    size_t nodeLimit = std::numeric_limits<size_t>::max(),
+    std::chrono::steady_clock::duration timeLimit =
+        std::chrono::steady_clock::duration::max());
+
+/**
+ * The size of a clique found by growing a clique from every node, always
+ * adding the candidate adjacent to the most other candidates. It is a lower
+ * bound of the chromatic number.
+ */
+size_t greedyCliqueSize(const Graph& graph);
+
+/**
+ * Exact coloring with at most ten million search nodes and one second.
+ */
+class ExactColoring {
+ public:
+  static void color(const Graph& graph, Coloring& coloring) {
+    exactColoring(graph, coloring, 10'000'000, std::chrono::seconds(1));
+  }
+};
+
+#endif
+/*** End of file: exact_coloring.h ***/
@@ -0,0 +1,107 @@
+/**
+ * Project: gal
+ * @file generators.h
+ * @date 17. 10. 2026
+ * @author xvitra00, xdocek09
+ * @brief Header file of module containing random graph generators.
+ */
+
+#ifndef GAL_GENERATORS_H
+#define GAL_GENERATORS_H
+
+#include <cstddef>
+#include <iosfwd>
+#include <limits>
+
+#include "graph_builder.hpp"
+
+/**
+ * Generates the edges of a G(n, p) random graph, every pair of nodes is
+ * connected with the probability p.
+ *
+ * Instead of a coin flip per pair the generator jumps straight to the next
+ * accepted pair with a geometrically distributed skip (Batagelj, Brandes:
+ * Efficient generation of large random networks), so it runs in time
+ * proportional to n + the number of edges. The rows are split to a fixed
+ * number of blocks with the same number of pairs, each with its own random
+ * stream, and the blocks are generated in parallel. The seed is drawn from
+ * gal_thread_random(), so called from the main thread the graph depends on
+ * the global seed only, not on the number of threads.
+ *
+ * @param nodeCount The number of nodes.
+ * @param probability The propability of an edge between two nodes.
+ * @param limit The upper limit for the number of edges.
+ * @param threads The number of threads, 0 means all hardware threads.
+ * @return Raw CSR arrays, each edge is stored once in the list of its node
+ * with the higher id, the lists are sorted.
+ */
+CsrArrays gnpEdges(size_t nodeCount,
+                   double probability,
+                   size_t limit = std::numeric_limits<size_t>::max(),
+                   unsigned threads = 1);
+
+/**
+ * Writes a uniformly random graph with exactly edgeCount edges (G(n, m)) in
+ * the text format of Graph(std::istream&). Each edge is written once,
+ * in the line of its node with the higher id.
+ *
+ * The edge indices are drawn as a sorted sample without replacement, so the
+ * lines are written as they are generated with constant memory and O(n + m)
+ * expected time. Graphs denser than one half sample the missing edges
+ * instead. The seed is drawn from gal_thread_random().
+ *
+ * @throw std::invalid_argument When there are more edges than node pairs.
+ */
+void writeGnm(std::ostream& os, size_t nodeCount, size_t edgeCount);
+
+/**
+ * Writes an R-MAT (recursive matrix) graph with a power-law degree
+ * distribution. Every one of edgeCount edges falls into the quadrants of the
+ * adjacency matrix with probabilities a, b, c and 1 - a - b - c, recursively
+ * down to a single cell.
+ *
+ * The rows are written in order: the number of edges of each row is drawn
+ * from the multinomial distribution one row at a time, then the column bits
+ * of each edge given the row bits, restricted to the columns below
+ * nodeCount. Memory does not depend on the size of the graph. Loops and
+ * duplicate edges are not filtered, the loader drops them, so the graph has
+ * somewhat fewer than edgeCount edges.
+ *
+ * @throw std::invalid_argument When the probabilities are not valid or give
+ * no cell of the nodeCount x nodeCount matrix a chance.
+ */
+void writeRmat(std::ostream& os,
+               size_t nodeCount,
+               size_t edgeCount,
+               double a = 0.57,
+               double b = 0.19,
+               double c = 0.19);
+
+/**
+ * Writes a Barabási–Albert preferential attachment graph: every node attaches
+ * edgesPerNode edges to earlier nodes chosen with the probability
+ * proportional to their degree.
+ *
+ * The target of each edge is computed from counter-based random numbers
+ * (Sanders, Schulz: Scalable generation of scale-free graphs), so the graph
+ * is written in constant memory. Loops and duplicate edges are left to the
+ * loader.
+ */
+void writeBarabasiAlbert(std::ostream& os,
+                         size_t nodeCount,
+                         size_t edgesPerNode);
+
+/**
+ * Writes a random geometric graph: nodes are random points in the unit square
+ * connected when their distance is at most radius.
+ *
+ * The square is divided to cells at least radius wide and the cells are
+ * generated row by row, so only two rows of cells are kept in memory. Nodes
+ * are numbered in the order of the cells.
+ *
+ * @throw std::invalid_argument When the radius is not positive.
+ */
+void writeGeometric(std::ostream& os, size_t nodeCount, double radius);
+
+#endif
+/*** End of file: generators.h ***/
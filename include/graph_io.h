@@ -0,0 +1,120 @@
+/**
+ * Project: gal
+ * @file graph_io.h
+ * @date 17. 10. 2026
+ * @author xvitra00, xdocek09
+ * @brief Header file of module for loading graphs from files.
+ */
+
+#ifndef GAL_GRAPH_IO_H
+#define GAL_GRAPH_IO_H
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+
+#include "graph.hpp"
+
+/**
+ * Read-only memory mapping of a whole file.
+ */
+class MappedFile {
+ public:
+  /**
+   * Maps the file.
+   *
+   * @throw std::runtime_error When the file cannot be opened or mapped.
+   */
+  explicit MappedFile(const std::string& filename);
+  ~MappedFile();
+
+  MappedFile(const MappedFile&) = delete;
+  MappedFile& operator=(const MappedFile&) = delete;
+
+  const char* data() const noexcept { return data_; }
+  size_t size() const noexcept { return size_; }
+
+ private:
+  const char* data_ = nullptr;
+  size_t size_ = 0;
+};
+
+/**
+ * Loads a graph from a file, either a binary snapshot written by
+ * saveSnapshot(), a DIMACS graph (see loadDimacs()) or the text format of
+ * Graph(std::istream&). DIMACS files are recognized by a leading 'c'
+ * or 'p' line, which the text format cannot contain.
+ *
+ * Snapshots are mapped read-only and used in place. Text files are memory
+ * mapped and split into chunks on line boundaries. The chunks are parsed in
+ * parallel with std::from_chars: the first pass counts lines and edges of
+ * each chunk, the second one writes the edges straight to their final place
+ * in preallocated CSR arrays.
+ *
+ * @param[in] filename	The graph file.
+ * @param[in] threads	The number of threads, 0 means all hardware threads.
+ * @throw std::runtime_error	When the file cannot be read.
+ * @throw std::invalid_argument	When the file is not a valid graph.
+ */
+Graph loadGraph(const std::string& filename, unsigned threads = 0);
+
+/**
+ * Loads a graph in the DIMACS format of the coloring benchmarks: comment
+ * lines "c ...", one problem line "p edge nodes edges" and edge lines
+ * "e u v" with nodes numbered from 1. Node lines "n ..." are ignored.
+ *
+ * @throw std::runtime_error	When the file cannot be read.
+ * @throw std::invalid_argument	When the file is not a valid DIMACS graph.
+ */
+Graph loadDimacs(const std::string& filename);
+
+/**
+ * The version of the snapshot format written by saveSnapshot().
+ */
+inline constexpr uint32_t SNAPSHOT_VERSION = 1;
+
+/**
+ * Header of a binary graph snapshot.
+ *
+ * The header is followed by nodeCount + 1 offsets and edgeCount adjacency
+ * entries, all of them 64 bit integers in the byte order of the machine that
+ * wrote the file. The edge lists are symmetric, sorted and without duplicates
+ * or loops, so the graph can be used without any further processing.
+ */
+struct SnapshotHeader {
+  char magic[8];
+  uint32_t version;
+  // 0x01020304 in the byte order of the writer
+  uint32_t byteOrder;
+  uint64_t nodeCount;
+  uint64_t edgeCount;
+  uint64_t reserved[4];
+};
+
+/**
+ * Writes the graph structure (without colors) as a binary snapshot.
+ *
+ * @throw std::runtime_error	When the file cannot be written.
+ */
+void saveSnapshot(const Graph& graph, const std::string& filename);
+
+/**
+ * Maps a binary snapshot read-only and uses its arrays in place.
+ *
+ * The header and the file size are always checked. The file is not trusted
+ * any further unless check is false: in O(n + m) the offsets are checked to
+ * be non-decreasing and every edge to point to a node, so a corrupted file
+ * cannot make the algorithms read out of bounds. loadGraph() always checks.
+ *
+ * @param[in] filename	The snapshot file.
+ * @param[in] check	Check the offsets and edges, skip only for trusted files.
+ * @param[in] threads	The number of threads, 0 means all hardware threads.
+ * @throw std::runtime_error	When the file cannot be read.
+ * @throw std::invalid_argument	When the file is not a valid snapshot.
+ */
+Graph loadSnapshot(const std::string& filename,
+                   bool check = true,
+                   unsigned threads = 0);
+
+#endif
+/*** End of file: graph_io.h ***/
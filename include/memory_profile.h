@@ -0,0 +1,85 @@
+/**
+ * Project: gal
+ * @file memory_profile.h
+ * @date 17. 10. 2026
+ * @author xvitra00, xdocek09
+ * @brief Header file of module measuring memory use of the process.
+ */
+
+#ifndef GAL_MEMORY_PROFILE_H
+#define GAL_MEMORY_PROFILE_H
+
+#include <cstddef>
+
+/**
+ * Heap allocations counted between startAllocationCounting() and
+ * stopAllocationCounting().
+ */
+struct AllocationStats {
+  size_t count = 0;
+  size_t bytes = 0;
+};
+
+/**
+ * Starts counting the allocations of all threads done through the global
+ * operator new, which memory_profile.cpp replaces. Outside of counting the
+ * replaced operator costs one relaxed atomic load more than malloc().
+ */
+void startAllocationCounting();
+
+/**
+ * Stops counting and returns the allocations since the start.
+ */
+AllocationStats stopAllocationCounting();
+
+/**
+ * The resident set size (VmRSS) of the process in bytes, 0 if unknown.
+ */
+size_t residentSetSize();
+
+/**
+ * The peak resident set size (VmHWM) of the process in bytes, 0 if unknown.
+ */
+size_t peakResidentSetSize();
+
+/**
+ * Resets the peak resident set size to the current one through
+ * /proc/self/clear_refs.
+ *
+ * @return False when the kernel does not allow it.
+ */
+bool resetPeakResidentSetSize();
+
+/**
+ * Measures the allocations and the growth of the peak resident set size
+ * during its lifetime.
+ */
+class MemoryProfile {
+ public:
+  MemoryProfile() {
+    // without a reset only growth above the old peak can be seen
+    rssBefore_ = resetPeakResidentSetSize() ? residentSetSize()
+                                            : peakResidentSetSize();
+    startAllocationCounting();
+  }
+
+  /**
+   * Stops the measurement, call it once.
+   */
+  void stop() {
+    allocations_ = stopAllocationCounting();
+    size_t peak = peakResidentSetSize();
+    peakRssDelta_ = peak > rssBefore_ ? peak - rssBefore_ : 0;
+  }
+
+  const AllocationStats& allocations() const noexcept { return allocations_; }
+  size_t peakRssDelta() const noexcept { return peakRssDelta_; }
+
+ private:
+  size_t rssBefore_ = 0;
+  AllocationStats allocations_;
+  size_t peakRssDelta_ = 0;
+};
+
+#endif
+/*** End of file: memory_profile.h ***/
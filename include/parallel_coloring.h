@@ -0,0 +1,105 @@
+/**
+ * Project: gal
+ * @file parallel_coloring.h
+ * @date 17. 10. 2026
+ * @author xvitra00, xdocek09
+ * @brief Header file of module containing multithreaded coloring algorithms.
+ */
+
+#ifndef GAL_PARALLEL_COLORING_H
+#define GAL_PARALLEL_COLORING_H
+
+#include <cstdint>
+#include <vector>
+
+#include "graph.hpp"
+
+/**
+ * Speculative multithreaded greedy coloring (Gebremedhin, Manne: Scalable
+ * parallel graph coloring algorithms; Çatalyürek et al.: Graph coloring
+ * algorithms for multi-core and massively multithreaded architectures).
+ *
+ * The nodes still to be colored are split into blocks, one per thread, and
+ * every thread colors its block greedily while the others may be coloring
+ * the neighbors at the same time. A parallel pass then finds the neighbors
+ * that got the same color; of each such pair the node later in the
+ * permutation is colored again in the next round, until there are no
+ * conflicts. With one thread it is the same as greedyColoring().
+ *
+ * @param[in] graph you want to color.
+ * @param[out] coloring	The colors of the graph.
+ * @param[in] nodesPermut	Permutation that defines order of nodes.
+ * @param[in] threads	The number of threads, 0 means all hardware threads.
+ */
+void parallelGreedyColoring(const Graph& graph,
+                            Coloring& coloring,
+                            const std::vector<size_t>& nodesPermut,
+                            unsigned threads = 0);
+
+/**
+ * Speculative multithreaded greedy coloring in the order of node ids.
+ */
+void parallelGreedyColoring(const Graph& graph,
+                            Coloring& coloring,
+                            unsigned threads = 0);
+
+/**
+ * Node priorities of the Jones-Plassmann coloring.
+ */
+enum class JonesPlassmannPriority {
+  // random priorities
+  RANDOM,
+  // larger degree first, random among equal degrees
+  LARGEST_DEGREE,
+};
+
+/**
+ * Jones-Plassmann coloring (Jones, Plassmann: A parallel graph coloring
+ * heuristic). A node is colored with the smallest color unused by its
+ * neighbors once all of its neighbors with higher priority are colored.
+ *
+ * Each round colors the current frontier, the uncolored nodes without
+ * uncolored neighbors of higher priority, in parallel. Frontier nodes are
+ * never adjacent. Threads take chunks of the frontier from a shared counter,
+ * so fast threads take over the work of slow ones, and collect the neighbors
+ * that become ready for the next round. The color of every node depends only
+ * on the priorities, so the result is the same for any number of threads and
+ * any timing.
+ *
+ * @param[in] graph you want to color.
+ * @param[out] coloring	The colors of the graph.
+ * @param[in] priority	How the priorities are chosen.
+ * @param[in] seed	Seed of the random priorities.
+ * @param[in] threads	The number of threads, 0 means all hardware threads.
+ */
+void jonesPlassmannColoring(
+    const Graph& graph,
+    Coloring& coloring,
+    JonesPlassmannPriority priority = JonesPlassmannPriority::RANDOM,
+    uint64_t seed = 0,
+    unsigned threads = 0);
+
+class ParallelGreedyColoring {
+ public:
+  static void color(const Graph& graph, Coloring& coloring) {
+    return parallelGreedyColoring(graph, coloring);
+  }
+};
+
+class JonesPlassmannColoring {
+ public:
+  static void color(const Graph& graph, Coloring& coloring) {
+    return jonesPlassmannColoring(graph, coloring);
+  }
+};
+
+class LargestDegreeJonesPlassmannColoring {
+ public:
+  static void color(const Graph& graph, Coloring& coloring) {
+    return jonesPlassmannColoring(
+        graph, coloring, JonesPlassmannPriority::LARGEST_DEGREE);
+  }
+};
+
+#endif
+/*** End of file: parallel_coloring.h ***/
@@ -0,0 +1,94 @@
+/**
+ * Project: gal
+ * @file perf_counters.h
+ * @date 17. 10. 2026
+ * @author xvitra00, xdocek09
+ * @brief Header file of module reading hardware performance counters.
+ */
+
+#ifndef GAL_PERF_COUNTERS_H
+#define GAL_PERF_COUNTERS_H
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <string>
+
+/**
+ * The counted hardware events.
+ */
+enum PerfEvent {
+  PERF_CYCLES,
+  PERF_INSTRUCTIONS,
+  PERF_L1D_MISSES,
+  PERF_LLC_MISSES,
+  PERF_BRANCH_MISSES,
+  PERF_DTLB_MISSES,
+  PERF_EVENT_COUNT,
+};
+
+/**
+ * Names of the events, for output.
+ */
+inline constexpr std::array<const char*, PERF_EVENT_COUNT> PERF_EVENT_NAMES = {
+    "cycles",
+    "instructions",
+    "l1dMisses",
+    "llcMisses",
+    "branchMisses",
+    "dtlbMisses",
+};
+
+/**
+ * Counts of one measurement. Events that cannot be counted are not valid.
+ */
+struct PerfSample {
+  std::array<uint64_t, PERF_EVENT_COUNT> values{};
+  std::array<bool, PERF_EVENT_COUNT> valid{};
+};
+
+/**
+ * Hardware counters of the calling thread and the threads it starts while
+ * the counters are open, in user space only, through perf_event_open(2).
+ *
+ * Every event is opened on its own, so an event the processor or the kernel
+ * does not offer, e.g. in a virtual machine or with a strict
+ * perf_event_paranoid, is just left out. When the kernel multiplexes the
+ * counters, the counts are scaled by the time each one actually ran.
+ */
+class PerfCounters {
+ public:
+  PerfCounters();
+  ~PerfCounters();
+
+  PerfCounters(const PerfCounters&) = delete;
+  PerfCounters& operator=(const PerfCounters&) = delete;
+
+  /**
+   * True when at least one event can be counted.
+   */
+  bool available() const noexcept;
+
+  /**
+   * Why the events that are missing could not be opened, empty if none is
+   * missing.
+   */
+  const std::string& error() const noexcept { return error_; }
+
+  /**
+   * Resets and starts the counters.
+   */
+  void start();
+
+  /**
+   * Stops the counters and reads them.
+   */
+  PerfSample stop();
+
+ private:
+  std::array<int, PERF_EVENT_COUNT> fds_;
+  std::string error_;
+};
+
+#endif
+/*** End of file: perf_counters.h ***/
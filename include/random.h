@@ -1,6 +1,137 @@
 #ifndef GAL_RAND_H
 #define GAL_RAND_H
 #include <cstddef>
+#include <cstdint>
+#include <iterator>
+#include <limits>
+#include <utility>
+
+/**
+ * Seedable random generator with independent streams (xoshiro256**).
+ *
+ * The state is derived from the seed and the stream number with splitmix64,
+ * so GalRandom(seed, i) for different i are independent generators that can
+ * be handed to threads or tasks. The results depend only on the seed and the
+ * stream, never on the standard library or on the thread that runs them.
+ */
+class GalRandom {
+ public:
+  using result_type = uint64_t;
+
+  explicit GalRandom(uint64_t seed, uint64_t stream = 0) {
+    uint64_t x = mix(seed ^ mix(stream + GOLDEN));
+    for (auto&& s : state_) {
+      x += GOLDEN;
+      s = mix(x);
+    }
+  }
+
+  static constexpr result_type min() { return 0; }
+  static constexpr result_type max() {
+    return std::numeric_limits<result_type>::max();
+  }
+
+  result_type operator()() {
+    const uint64_t result = rotl(state_[1] * 5, 7) * 9;
+    const uint64_t t = state_[1] << 17;
+    state_[2] ^= state_[0];
+    state_[3] ^= state_[1];
+    state_[1] ^= state_[2];
+    state_[0] ^= state_[3];
+    state_[2] ^= t;
+    state_[3] = rotl(state_[3], 45);
+    return result;
+  }
+
+  /**
+   * Unbiased random size_t in <0, upTo), upTo must not be 0.
+   */
+  size_t uniform(size_t upTo) {
+    // values below the threshold would make the low results more likely
+    const uint64_t threshold = (0 - static_cast<uint64_t>(upTo)) % upTo;
+    uint64_t r;
+    do {
+      r = (*this)();
+    } while (r < threshold);
+    return r % upTo;
+  }
+
+  /**
+   * Random double in <0, 1) with 53 random bits.
+   */
+  double uniformReal() { return ((*this)() >> 11) * 0x1.0p-53; }
+
+  /**
+   * Binomial random count of successes in the given number of trials.
+   * Inversion for a mean below 10, otherwise the transformed rejection of
+   * Hormann (BTRD). Both are exact and the same with every standard library.
+   */
+  uint64_t binomial(uint64_t trials, double probability);
+
+  /**
+   * Fills <first, first + count) with uniformReal() values.
+   */
+  void fill(double* first, size_t count) {
+    for (size_t i = 0; i < count; ++i) {
+      first[i] = uniformReal();
+    }
+  }
+
+  /**
+   * Fisher-Yates shuffle. Unlike std::shuffle, the result is the same with
+   * every standard library.
+   */
+  template <typename RandomIt>
+  void shuffle(RandomIt first, RandomIt last) {
+    using std::swap;
+    auto size = static_cast<size_t>(std::distance(first, last));
+    for (size_t i = size; i > 1; --i) {
+      swap(first[i - 1], first[uniform(i)]);
+    }
+  }
+
+ private:
+  static constexpr uint64_t GOLDEN = 0x9e3779b97f4a7c15;
+
+  static uint64_t rotl(uint64_t x, int k) { return (x << k) | (x >> (64 - k)); }
+
+  // splitmix64 finalizer
+  static uint64_t mix(uint64_t z) {
+    z = (z ^ (z >> 30)) * 0xbf58476d1ce4e5b9;
+    z = (z ^ (z >> 27)) * 0x94d049bb133111eb;
+    return z ^ (z >> 31);
+  }
+
+  uint64_t state_[4];
+};
+
+/**
+ * Sets the global seed. Until it is called, the seed comes from
+ * std::random_device.
+ */
+void gal_seed(uint64_t seed);
+
+/**
+ * The global seed.
+ */
+uint64_t gal_seed();
+
+/**
+ * Generator of the given stream of the global seed. Code that must give the
+ * same results with any number of threads numbers its tasks and uses one
+ * stream per task.
+ */
+GalRandom gal_stream(uint64_t stream);
+
+/**
+ * The generator of the calling thread, used by gal_rand. The first thread of
+ * the process to ask, normally the main thread, always gets the first stream
+ * of the global seed, so its sequence is reproducible. Other threads get
+ * streams in the order they ask, which depends on timing, so code running on
+ * worker threads that must be reproducible uses gal_stream(task) instead.
+ * The generator is restarted whenever gal_seed(seed) is called.
+ */
+GalRandom& gal_thread_random();
 
 size_t gal_rand(size_t upTo);
 size_t gal_rand(size_t from, size_t upTo);
@@ -8,4 +139,4 @@ size_t gal_rand(size_t from, size_t upTo);
 double gal_rand(double upTo);
 double gal_rand(double from, double upTo);
 
-#endif
\ No newline at end of file
+#endif
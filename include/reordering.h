@@ -0,0 +1,74 @@
+/**
+ * Project: gal
+ * @file reordering.h
+ * @date 17. 10. 2026
+ * @author xvitra00, xdocek09
+ * @brief Header file of module relabeling nodes for better memory locality.
+ */
+
+#ifndef GAL_REORDERING_H
+#define GAL_REORDERING_H
+
+#include <vector>
+
+#include "graph.hpp"
+
+/**
+ * Orders of the nodes for relabeling.
+ */
+enum class NodeOrdering {
+  // reverse Cuthill-McKee: breadth-first search from a node of the smallest
+  // degree, neighbors by increasing degree, the whole order reversed
+  RCM,
+  // breadth-first search from the smallest unvisited id
+  BFS,
+  // decreasing degree, ties by id
+  DEGREE,
+};
+
+/**
+ * Computes a node order in which neighbors tend to get close ids, so the
+ * colors of the neighbors of a node lie in few cache lines.
+ *
+ * @return The old id of each new id.
+ */
+std::vector<size_t> localityOrdering(const Graph& graph,
+                                     NodeOrdering ordering);
+
+/**
+ * Builds a copy of the graph with new ids: new node i is the old node
+ * order[i].
+ *
+ * @param[in] order	A permutation of the node ids.
+ */
+Graph relabelGraph(const Graph& graph, const std::vector<size_t>& order);
+
+/**
+ * Copies the coloring of a relabeled graph back to the original ids.
+ *
+ * @param[in] relabeled	The coloring of the graph returned by relabelGraph().
+ * @param[in] order	The permutation it was relabeled with.
+ * @param[out] original	The coloring of the graph with the original ids.
+ */
+void mapColorsBack(const Coloring& relabeled,
+                   const std::vector<size_t>& order,
+                   Coloring& original);
+
+/**
+ * Runs the coloring algorithm CG on a relabeled copy of the graph and maps
+ * the colors back, so the relabeling cost is part of the measurement.
+ */
+template <typename CG, NodeOrdering ORDERING>
+class RelabeledColoring {
+ public:
+  static void color(const Graph& graph, Coloring& coloring) {
+    auto order = localityOrdering(graph, ORDERING);
+    Graph relabeled = relabelGraph(graph, order);
+    Coloring relabeledColoring(relabeled.size());
+    CG::color(relabeled, relabeledColoring);
+    mapColorsBack(relabeledColoring, order, coloring);
+  }
+};
+
+#endif
+/*** End of file: reordering.h ***/
@@ -0,0 +1,121 @@
+/**
+ * Project: gal
+ * @file sharded_coloring.h
+ * @date 17. 10. 2026
+ * @author xvitra00, xdocek09
+ * @brief Header file of module coloring graph shards in worker processes.
+ */
+
+#ifndef GAL_SHARDED_COLORING_H
+#define GAL_SHARDED_COLORING_H
+
+#include <cstddef>
+#include <string>
+#include <vector>
+
+#include "graph.hpp"
+
+/**
+ * How the nodes are split into shards.
+ */
+enum class ShardPartition {
+  // contiguous ranges of node ids with about the same number of edges
+  RANGES,
+  // regions grown by breadth-first search, fewer cut edges on most graphs
+  BFS,
+};
+
+/**
+ * Assigns every node to one of the shards.
+ *
+ * @return The shard of each node, all in <0, shards).
+ */
+std::vector<unsigned> partitionGraph(const Graph& graph,
+                                     unsigned shards,
+                                     ShardPartition partition);
+
+/**
+ * Outcome of shardedColoring().
+ */
+struct ShardedColoringResult {
+  // conflict resolution rounds after the first coloring of the shards
+  size_t rounds = 0;
+  // bytes written to and read from the workers
+  size_t bytesSent = 0;
+  size_t bytesReceived = 0;
+  // nodes with a neighbor in another shard
+  size_t boundaryNodes = 0;
+  // boundary nodes recolored in all rounds together
+  size_t recolored = 0;
+};
+
+/**
+ * Colors the graph with one worker process per shard.
+ *
+ * The coordinator forks the workers and sends each of them its shard over a
+ * socket pair: the owned nodes with their global ids, their edges inside the
+ * shard in local ids and their edges to other shards in global ids. A worker
+ * keeps only its shard and colors it greedily, ignoring the other shards,
+ * and sends back the colors of its boundary nodes.
+ *
+ * In every round the coordinator broadcasts the colors changed in the last
+ * one. Each worker updates the colors of its neighbors in other shards and,
+ * of each pair of equally colored neighbors across the cut, recolors the
+ * node with the larger id if it owns it, with the smallest color free among
+ * all of its neighbors. Recoloring keeps the shard itself valid, so the
+ * rounds end when no worker recolors a node. Finally the workers send all of
+ * their colors and exit. The coordinator itself never reads the edges.
+ *
+ * This variant spreads the work but not the memory: the caller holds the
+ * whole graph and the forked workers share its pages. Graphs that do not fit
+ * one process go through the snapshot variant below.
+ *
+ * @param[in] graph you want to color.
+ * @param[out] coloring	The colors of the graph.
+ * @param[in] workers	The number of worker processes, 0 means one per
+ * hardware thread.
+ * @param[in] partition	How the graph is split.
+ * @throw std::runtime_error When a worker cannot be started or fails.
+ */
+ShardedColoringResult shardedColoring(
+    const Graph& graph,
+    Coloring& coloring,
+    unsigned workers = 0,
+    ShardPartition partition = ShardPartition::BFS);
+
+/**
+ * Colors a graph saved by saveSnapshot() with one worker process per
+ * contiguous range of nodes, without any process holding the whole graph.
+ *
+ * The workers are forked before anything is loaded and each of them maps
+ * the snapshot and copies only the offsets and edges of its range, checking
+ * them on the way. The coordinator maps the snapshot only to weigh the
+ * ranges by the offsets and keeps a few values per node, never an edge.
+ * Mapped pages are read on first access, so no process reads the whole
+ * adjacency. The rounds are those of shardedColoring() above.
+ *
+ * @param[in] snapshot	The snapshot file.
+ * @param[out] coloring	The colors of the graph, of the size of the graph.
+ * @param[in] workers	The number of worker processes, 0 means one per
+ * hardware thread.
+ * @throw std::runtime_error When the file cannot be read, or a worker cannot
+ * be started or fails, e.g. on a corrupted range.
+ * @throw std::invalid_argument When the file is not a snapshot or the
+ * coloring does not match it.
+ */
+ShardedColoringResult shardedColoring(const std::string& snapshot,
+                                      Coloring& coloring,
+                                      unsigned workers = 0);
+
+/**
+ * Sharded coloring with four worker processes and BFS partitioning.
+ */
+class ShardedColoring {
+ public:
+  static void color(const Graph& graph, Coloring& coloring) {
+    shardedColoring(graph, coloring, 4);
+  }
+};
+
+#endif
+/*** End of file: sharded_coloring.h ***/
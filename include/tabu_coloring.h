@@ -0,0 +1,95 @@
+/**
+ * Project: gal
+ * @file tabu_coloring.h
+ * @date 17. 10. 2026
+ * @author xvitra00, xdocek09
+ * @brief Header file of module containing the tabucol local search.
+ */
+
+#ifndef GAL_TABU_COLORING_H
+#define GAL_TABU_COLORING_H
+
+#include <chrono>
+#include <cstddef>
+#include <limits>
+
+#include "graph.hpp"
+
+/**
+ * Outcome of tabucol().
+ */
+struct TabucolResult {
+  // a coloring without conflicts was found
+  bool success = false;
+  // the fewest conflicting edges seen
+  size_t conflicts = 0;
+  // the number of moves done
+  size_t moves = 0;
+  // the time spent moving, without the setup
+  double seconds = 0.0;
+  double movesPerSecond = 0.0;
+};
+
+/**
+ * Searches for a coloring with at most k colors with tabucol (Hertz, de
+ * Werra: Using tabu search techniques for graph coloring; Galinier, Hao:
+ * Hybrid evolutionary algorithms for graph coloring).
+ *
+ * Every node always has one of the k colors and the search minimizes the
+ * number of edges whose endpoints share a color. A move recolors a node that
+ * has such an edge. The best move is found from a flat n * k table holding,
+ * for every node and color, the number of neighbors with that color; a move
+ * updates the rows of the neighbors only, so it costs O(degree) besides the
+ * scan of the conflicting nodes. The old color of a moved node is tabu for
+ * that node for a random number of moves plus 0.6 times the number of
+ * conflicting nodes, unless taking it would beat the best state seen.
+ *
+ * The search starts from the given coloring. Colors above k
+ * and missing colors are replaced with random ones. It stops as soon as there
+ * are no conflicts or when a budget is spent.
+ *
+ * Random choices come from gal_thread_random().
+ *
+ * @param[in] graph	The graph.
+ * @param[in|out] coloring	A coloring of the graph, it gets the found
+ * coloring on success and is left unchanged otherwise.
+ * @param[in] k	The color budget.
+ * @param[in] maxMoves	The move budget.
+ * @param[in] timeLimit	The wall-clock budget.
+ * @throw std::invalid_argument When k is 0 and the graph is not empty.
+ */
+TabucolResult tabucol(const Graph& graph,
+                      Coloring& coloring,
+                      size_t k,
+                      size_t maxMoves = std::numeric_limits<size_t>::max(),
+                      std::chrono::steady_clock::duration timeLimit =
+                          std::chrono::steady_clock::duration::max());
+
+/**
+ * Colors the graph with DSatur and then removes one color after another with
+ * tabucol until it fails or a budget is spent. The budgets and the result
+ * are totals over all the tabucol runs; success and conflicts are those of
+ * the last run.
+ *
+ * @param[in] graph	The graph.
+ * @param[out] coloring	It gets the best valid coloring found.
+ */
+TabucolResult tabucolColoring(
+    const Graph& graph,
+    Coloring& coloring,
+    size_t maxMoves = std::numeric_limits<size_t>::max(),
+    std::chrono::steady_clock::duration timeLimit =
+        std::chrono::steady_clock::duration::max());
+
+/**
+ * DSatur improved by tabucol with at most ten million moves in one second.
+ */
+class TabucolColoring {
+ public:
+  static void color(const Graph& graph, Coloring& coloring) {
+    tabucolColoring(graph, coloring, 10'000'000, std::chrono::seconds(1));
+  }
+};
+
+#endif
+/*** End of file: tabu_coloring.h ***/
@@ -0,0 +1,100 @@
+/**
+ * Project: gal
+ * @file trace.h
+ * @date 17. 10. 2026
+ * @author xvitra00, xdocek09
+ * @brief Header file of module recording timed spans of program phases.
+ */
+
+#ifndef GAL_TRACE_H
+#define GAL_TRACE_H
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <ostream>
+
+/**
+ * The number of spans kept per thread, older ones are overwritten.
+ */
+inline constexpr size_t TRACE_RING_EVENTS = 1 << 16;
+
+/**
+ * Collects spans into one ring buffer per thread and exports them in the
+ * Chrome trace event format, which chrome://tracing and Perfetto open.
+ *
+ * Recording is off until enable(true). A span of a disabled tracer costs one
+ * relaxed atomic load. A recorded span costs two clock reads and a store to
+ * the buffer of its thread; only the first span of a thread takes a lock.
+ */
+class Tracer {
+ public:
+  static bool enabled() noexcept {
+    return enabled_.load(std::memory_order_relaxed);
+  }
+
+  static void enable(bool on) noexcept {
+    enabled_.store(on, std::memory_order_relaxed);
+  }
+
+  /**
+   * Nanoseconds since the start of the process.
+   */
+  static uint64_t now() noexcept;
+
+  /**
+   * Records a finished span of the calling thread.
+   *
+   * @param[in] name	A string that lives until the export, e.g. a literal.
+   */
+  static void record(const char* name, uint64_t start, uint64_t end) noexcept;
+
+  /**
+   * Writes all recorded spans as Chrome trace JSON. The threads must not
+   * record meanwhile.
+   */
+  static void writeChromeTrace(std::ostream& os);
+
+ private:
+  static inline std::atomic<bool> enabled_{false};
+};
+
+/**
+ * Records the time from its construction to its destruction as a span.
+ */
+class TraceSpan {
+ public:
+  explicit TraceSpan(const char* name) noexcept
+      : name_(Tracer::enabled() ? name : nullptr),
+        start_(name_ != nullptr ? Tracer::now() : 0) {}
+
+  ~TraceSpan() {
+    if (name_ != nullptr) {
+      Tracer::record(name_, start_, Tracer::now());
+    }
+  }
+
+  TraceSpan(const TraceSpan&) = delete;
+  TraceSpan& operator=(const TraceSpan&) = delete;
+
+ private:
+  const char* name_;
+  uint64_t start_;
+};
+
+#define GAL_TRACE_CONCAT_(a, b) a##b
+#define GAL_TRACE_CONCAT(a, b) GAL_TRACE_CONCAT_(a, b)
+
+/**
+ * Traces the rest of the enclosing scope under a literal name. Defining
+ * GAL_NO_TRACE (make NO_TRACE=1) removes all spans from the build.
+ */
+#ifdef GAL_NO_TRACE
+#define GAL_TRACE_SPAN(name) ((void)0)
+#else
+#define GAL_TRACE_SPAN(name) \
+  TraceSpan GAL_TRACE_CONCAT(galTraceSpan, __LINE__)(name)
+#endif
+
+#endif
+/*** End of file: trace.h ***/
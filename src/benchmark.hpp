@@ -1,17 +1,70 @@
 #ifndef GAL_BENCHMARK_HPP
 #define GAL_BENCHMARK_HPP
 
+#include <algorithm>
+#include <array>
 #include <chrono>
+#include <cmath>
 #include <fstream>
+#include <iostream>
+#include <limits>
 #include <numeric>
+#include <optional>
+#include <ostream>
+#include <sstream>
+#include <stdexcept>
 #include <string>
 #include <vector>
 
 #include <cassert>
 #include "coloring_alg.h"
 #include "graph.hpp"
+#include "trace.h"
+#include "graph_io.h"
+#include "memory_profile.h"
+#include "perf_counters.h"
+#include "random.h"
 
-inline constexpr size_t BENCHMARK_ITERATIONS = 5;
+/**
+ * How long a benchmark runs.
+ */
+struct BenchmarkSettings {
+  // untimed runs before the measurement, they warm up caches and allocators
+  size_t warmupIterations = 1;
+  // timed runs done always
+  size_t minIterations = 5;
+  // timed runs done at most, at least 1 and at least minIterations
+  size_t maxIterations = 100;
+  // stop once the 95% confidence interval of the mean is within this
+  // fraction of the mean
+  double targetRelativeCi = 0.02;
+  // stop adding runs to a graph after this many milliseconds
+  double maxMilliseconds = 10000.0;
+  // read hardware counters around every timed run
+  bool perfCounters = false;
+  // global seed set before every run, randomized algorithms repeat exactly
+  uint64_t seed = 2018;
+};
+
+/**
+ * The two-sided 95% quantile of the Student t distribution.
+ *
+ * @param[in] df	Degrees of freedom, at least 1.
+ */
+inline double studentT95(size_t df) {
+  static constexpr std::array<double, 30> TABLE = {
+      12.706, 4.303, 3.182, 2.776, 2.571, 2.447, 2.365, 2.306, 2.262, 2.228,
+      2.201,  2.179, 2.160, 2.145, 2.131, 2.120, 2.110, 2.101, 2.093, 2.086,
+      2.080,  2.074, 2.069, 2.064, 2.060, 2.056, 2.052, 2.048, 2.045, 2.042};
+  if (df == 0) {
+    return std::numeric_limits<double>::infinity();
+  }
+  if (df <= TABLE.size()) {
+    return TABLE[df - 1];
+  }
+  // close enough to the limit for larger samples
+  return df <= 60 ? 2.000 : df <= 120 ? 1.980 : 1.960;
+}
 
 struct BenchmarkResult {
   double sum = 0.0;
@@ -19,79 +72,277 @@ struct BenchmarkResult {
   double max = 0.0;
   double average = 0.0;
   double median = 0.0;
+  // sample standard deviation
+  double stddev = 0.0;
+  // half width of the 95% confidence interval of the average
+  double ciHalfWidth = 0.0;
+  double p5 = 0.0;
+  double p25 = 0.0;
+  double p75 = 0.0;
+  double p95 = 0.0;
+  size_t iterations = 0;
+  size_t warmupIterations = 0;
+  // heap allocations and growth of the peak resident set in the first run
+  size_t allocationCount = 0;
+  size_t allocatedBytes = 0;
+  size_t peakRssDelta = 0;
+  // hardware counters per timed run on average, only with perfCounters set
+  std::array<double, PERF_EVENT_COUNT> perf{};
+  std::array<bool, PERF_EVENT_COUNT> perfValid{};
 
   bool resultValid;
   size_t colorCount;
 
-  /**\
+  /**
+   * The confidence interval half width relative to the average.
+   */
+  double relativeCi() const noexcept {
+    return average > 0.0 ? ciHalfWidth / average : 0.0;
+  }
+
+  /**
    * Set the benchmark results from a range of measurements.
    */
   template <typename Iterator>
-  void set(Iterator begin, Iterator end, const ColoredGraph& g) {
+  void set(Iterator begin,
+           Iterator end,
+           const Graph& g,
+           const Coloring& coloring) {
     size_t size = end - begin;
     assert(size != 0);
 
     std::sort(begin, end);
-    min = *(end - 1);
-    max = *begin;
+    min = *begin;
+    max = *(end - 1);
     sum = std::accumulate(begin, end, 0.0);
     average = sum / size;
-    median = *(begin + size / 2);
+    median = percentile(begin, size, 0.5);
+    p5 = percentile(begin, size, 0.05);
+    p25 = percentile(begin, size, 0.25);
+    p75 = percentile(begin, size, 0.75);
+    p95 = percentile(begin, size, 0.95);
 
-    resultValid = g.validateColors();
-    colorCount = g.colorCount();
+    double squares = 0.0;
+    for (auto it = begin; it != end; ++it) {
+      squares += (*it - average) * (*it - average);
+    }
+    stddev = size > 1 ? std::sqrt(squares / (size - 1)) : 0.0;
+    ciHalfWidth = size > 1 ? studentT95(size - 1) * stddev / std::sqrt(size)
+                           : std::numeric_limits<double>::infinity();
+    iterations = size;
+
+    resultValid = coloring.validate(g);
+    colorCount = coloring.colorCount();
+  }
+
+ private:
+  // linear interpolation between the closest ranks of sorted values
+  template <typename Iterator>
+  static double percentile(Iterator sorted, size_t size, double fraction) {
+    double rank = fraction * (size - 1);
+    size_t below = static_cast<size_t>(rank);
+    if (below + 1 >= size) {
+      return *(sorted + (size - 1));
+    }
+    double weight = rank - below;
+    return *(sorted + below) * (1.0 - weight) + *(sorted + below + 1) * weight;
   }
 };
 
+/**
+ * Writes the statistics of a result as JSON object members, without the
+ * braces, so the caller can add more members.
+ */
+inline void writeJsonMembers(std::ostream& os, const BenchmarkResult& r) {
+  // infinity is not valid JSON
+  auto number = [](double value) {
+    if (!std::isfinite(value)) {
+      return std::string("null");
+    }
+    std::ostringstream os;
+    os.precision(10);
+    os << value;
+    return os.str();
+  };
+  os << "\"iterations\": " << r.iterations
+     << ", \"warmupIterations\": " << r.warmupIterations
+     << ", \"min\": " << number(r.min) << ", \"max\": " << number(r.max)
+     << ", \"average\": " << number(r.average)
+     << ", \"median\": " << number(r.median)
+     << ", \"stddev\": " << number(r.stddev)
+     << ", \"ciHalfWidth\": " << number(r.ciHalfWidth)
+     << ", \"p5\": " << number(r.p5) << ", \"p25\": " << number(r.p25)
+     << ", \"p75\": " << number(r.p75) << ", \"p95\": " << number(r.p95)
+     << ", \"allocationCount\": " << r.allocationCount
+     << ", \"allocatedBytes\": " << r.allocatedBytes
+     << ", \"peakRssDelta\": " << r.peakRssDelta
+     << ", \"valid\": " << (r.resultValid ? "true" : "false")
+     << ", \"colors\": " << r.colorCount;
+  if (std::find(r.perfValid.begin(), r.perfValid.end(), true) !=
+      r.perfValid.end()) {
+    os << ", \"perf\": {";
+    for (size_t i = 0; i < PERF_EVENT_COUNT; ++i) {
+      os << (i == 0 ? "\"" : ", \"") << PERF_EVENT_NAMES[i] << "\": "
+         << (r.perfValid[i] ? number(r.perf[i]) : "null");
+    }
+    os << '}';
+  }
+}
+
+/**
+ * Writes a string as a JSON string literal.
+ */
+inline void writeJsonString(std::ostream& os, const std::string& s) {
+  static constexpr char HEX[] = "0123456789abcdef";
+  os << '"';
+  for (unsigned char c : s) {
+    if (c == '"' || c == '\\') {
+      os << '\\' << c;
+    } else if (c < 0x20) {
+      os << "\\u00" << HEX[c >> 4] << HEX[c & 15];
+    } else {
+      os << c;
+    }
+  }
+  os << '"';
+}
+
 /**
  * Benchmark a set of graphs given by filenames. The algorithm class is given in
  * the template argument.
  */
 template <typename CG>
 inline std::vector<BenchmarkResult> benchmark(
-    const std::vector<std::string>& graphFilenames) {
-  std::vector<ColoredGraph> graphs{};
+    const std::vector<std::string>& graphFilenames,
+    const BenchmarkSettings& settings = {}) {
+  std::vector<Graph> graphs{};
 
   for (auto&& filename : graphFilenames) {
-    std::ifstream is(filename);
-    graphs.push_back({is});
+    graphs.push_back(loadGraph(filename));
   }
 
-  return std::move(benchmark<CG>(std::move(graphs)));
+  return benchmark<CG>(graphs, settings);
 }
 
 /**
  * Benchmark a vector of graphs. The algorithm class is given in the tepmlate
- * argument.
+ * argument. The graphs are only read, every graph gets one coloring that is
+ * cleared before each run.
+ *
+ * Every graph is colored settings.warmupIterations times without timing and
+ * then at least settings.minIterations times with timing. More timed runs
+ * are added until the confidence interval of the average time is narrow
+ * enough, or the iteration or time budget is spent. The coloring of the last
+ * timed run is the one validated and reported.
+ *
+ * The memory of the first warm-up run is profiled: the number and size of
+ * heap allocations and how much the peak resident set size grew. Without
+ * warm-up runs, one extra untimed run is made for the profile, so the
+ * profiling never happens in the timed part.
+ *
+ * With settings.perfCounters, hardware counters are read around every timed
+ * run and averaged. Counters the system does not offer are left out.
+ *
+ * Every run starts with gal_seed(settings.seed), so randomized algorithms
+ * give the same coloring in every run and every invocation.
  */
 template <typename CG>
 inline std::vector<BenchmarkResult> benchmark(
-    std::vector<ColoredGraph> graphs) {
+    const std::vector<Graph>& graphs,
+    const BenchmarkSettings& settings = {}) {
   using namespace std::chrono;
+  if (settings.maxIterations == 0 ||
+      settings.minIterations > settings.maxIterations) {
+    throw std::invalid_argument(
+        "benchmark: maxIterations must be positive and at least "
+        "minIterations");
+  }
   std::vector<BenchmarkResult> results;
-  std::array<double, BENCHMARK_ITERATIONS> timeArray{};
+  std::vector<double> times;
   results.reserve(graphs.size());
+  std::optional<PerfCounters> counters;
+  if (settings.perfCounters) {
+    counters.emplace();
+  }
 
   for (auto&& g : graphs) {
     results.push_back({});
     auto&& result = results.back();
+    Coloring coloring(g.size());
 
-    for (size_t i = 0; i < BENCHMARK_ITERATIONS; ++i) {
-      g.clearColors();
+    // the first warm-up run, or an extra untimed one, is profiled
+    for (size_t i = 0; i < std::max<size_t>(settings.warmupIterations, 1);
+         ++i) {
+      GAL_TRACE_SPAN("warm-up run");
+      coloring.clear();
+      gal_seed(settings.seed);
+      if (i != 0) {
+        CG::color(g, coloring);
+        continue;
+      }
+      MemoryProfile memory;
+      CG::color(g, coloring);
+      memory.stop();
+      result.allocationCount = memory.allocations().count;
+      result.allocatedBytes = memory.allocations().bytes;
+      result.peakRssDelta = memory.peakRssDelta();
+    }
+    result.warmupIterations = settings.warmupIterations;
+
+    times.clear();
+    double total = 0.0;
+    std::array<double, PERF_EVENT_COUNT> perfSums{};
+    std::array<size_t, PERF_EVENT_COUNT> perfRuns{};
+    while (times.size() < settings.maxIterations) {
+      GAL_TRACE_SPAN("timed run");
+      coloring.clear();
+      gal_seed(settings.seed);
+      if (counters) {
+        counters->start();
+      }
       auto begin = steady_clock::now();
-      CG::color(g);
+      CG::color(g, coloring);
       auto end = steady_clock::now();
+      if (counters) {
+        auto sample = counters->stop();
+        for (size_t i = 0; i < PERF_EVENT_COUNT; ++i) {
+          if (sample.valid[i]) {
+            perfSums[i] += sample.values[i];
+            ++perfRuns[i];
+          }
+        }
+      }
       double time = duration<double, std::milli>(end - begin).count();
-      timeArray[i] = time;
+      times.push_back(time);
+      total += time;
+
+      if (times.size() < std::max<size_t>(settings.minIterations, 2)) {
+        continue;
+      }
+      if (total >= settings.maxMilliseconds) {
+        break;
+      }
+      const size_t n = times.size();
+      const double average = total / n;
+      double squares = 0.0;
+      for (double t : times) {
+        squares += (t - average) * (t - average);
+      }
+      double halfWidth = studentT95(n - 1) * std::sqrt(squares / (n - 1) / n);
+      if (halfWidth <= settings.targetRelativeCi * average) {
+        break;
+      }
+    }
+    result.set(times.begin(), times.end(), g, coloring);
+    for (size_t i = 0; i < PERF_EVENT_COUNT; ++i) {
+      result.perfValid[i] = perfRuns[i] != 0;
+      result.perf[i] = perfRuns[i] != 0 ? perfSums[i] / perfRuns[i] : 0.0;
     }
-    if (!g.validateColors()) {
+    if (!result.resultValid) {
       std::cerr << "error: coloring not valid.\n";
     }
-    g.clearColors();
-    CG::color(g);
-    result.set(timeArray.begin(), timeArray.end(), g);
   }
-  return std::move(results);
+  return results;
 }
 
-#endif
\ No newline at end of file
+#endif
@@ -0,0 +1,110 @@
+/**
+ * Project: gal
+ * @file color_kernels.hpp
+ * @date 17. 10. 2026
+ * @author xvitra00, xdocek09
+ * @brief Kernels finding the smallest color unused by the neighbors of a node.
+ */
+#ifndef GAL_COLOR_KERNELS_HPP
+#define GAL_COLOR_KERNELS_HPP
+
+#include <algorithm>
+#include <cstdint>
+#include <vector>
+
+#include "graph.hpp"
+
+/**
+ * Marks the neighbor colors in a scratch bitset of degree + 2 bits rounded up
+ * to whole words and finds the first zero bit a word at a time.
+ *
+ * Bit c stands for color c. A node of degree d always has an unused color in
+ * <1, d + 1>, so larger colors are clamped to a sentinel bit past that range.
+ * Bit 0 of NO_COLOR is always set, so it is never a result. The marking loop
+ * therefore has no branches and only the words the node can use are cleared.
+ */
+class BitsetColorKernel {
+ public:
+  size_t smallestUnused(const Graph::Edges& neighbors,
+                        const Coloring& coloring) {
+    const size_t limit = neighbors.size() + 2;
+    const size_t words = limit / 64 + 1;
+    if (words_.size() < words) {
+      words_.resize(words);
+    }
+    std::fill_n(words_.begin(), words, 0);
+    words_[0] = 1;
+
+    const size_t* colors = coloring.colors().data();
+    for (auto neighbor : neighbors) {
+      size_t color = std::min(colors[neighbor], limit);
+      words_[color / 64] |= uint64_t{1} << (color % 64);
+    }
+    size_t i = 0;
+    while (words_[i] == ~uint64_t{0}) {
+      ++i;
+    }
+    return i * 64 + __builtin_ctzll(~words_[i]);
+  }
+
+ private:
+  std::vector<uint64_t> words_;
+};
+
+/**
+ * Stamps the neighbor colors with the number of the current call in an array
+ * indexed by color, so the marks of earlier calls are simply stale and never
+ * need a clearing pass. The scan for the first unstamped color goes color by
+ * color, which is cheap while the colors of the neighbors are mostly small.
+ */
+class StampColorKernel {
+ public:
+  /**
+   * @param[in] nodeCount	The number of nodes, no color exceeds it.
+   */
+  explicit StampColorKernel(size_t nodeCount) : stamps_(nodeCount + 2, 0) {}
+
+  /**
+   * Makes room for the colors of a graph with more nodes.
+   */
+  void resize(size_t nodeCount) {
+    if (stamps_.size() < nodeCount + 2) {
+      stamps_.resize(nodeCount + 2, 0);
+    }
+  }
+
+  size_t smallestUnused(const Graph::Edges& neighbors,
+                        const Coloring& coloring) {
+    const size_t* colors = coloring.colors().data();
+    return smallestUnusedOf(neighbors,
+                            [colors](size_t node) { return colors[node]; });
+  }
+
+  /**
+   * Variant reading the colors through colorOf(node), e.g. from atomics.
+   */
+  template <typename ColorOf>
+  size_t smallestUnusedOf(const Graph::Edges& neighbors,
+                          ColorOf&& colorOf) {
+    if (++stamp_ == 0) {
+      // wrapped around, old stamps could collide
+      std::fill(stamps_.begin(), stamps_.end(), 0);
+      stamp_ = 1;
+    }
+    for (auto neighbor : neighbors) {
+      stamps_[colorOf(neighbor)] = stamp_;
+    }
+    size_t color = Coloring::FIRST_COLOR;
+    while (stamps_[color] == stamp_) {
+      ++color;
+    }
+    return color;
+  }
+
+ private:
+  std::vector<uint32_t> stamps_;
+  uint32_t stamp_ = 0;
+};
+
+#endif
+/*** End of file: color_kernels.hpp ***/
@@ -9,95 +9,61 @@
 #include "coloring_alg.h"
 
 #include <algorithm>
-#include <deque>
+#include <chrono>
+#include <cstdint>
+#include <limits>
 #include <numeric>
 #include <set>
-#include <tuple>
-#include <unordered_set>
 #include <utility>
-/**
- * Finds smallest color that any of provided neighbors does not have.
- *
- * @param[in] neighbors	for color search.
- * @param[in|out] neighboursColors
- * 	This parameter is here to save allocation by reusing same vector in multiple
- * calls. It is used as vector of flags where index is color and value is
- * used(true)/not used(false). Recommended size: Number of nodes in graph.
- * 	!!! Do not forget to pass only cleared vector (all false).
- * 	This function will clear that vector after work is done.
- * @param[in] graph Graph we are working on.
- * @return Smallest unused color among the neighbors. If graph.NO_COLOR is
- * returned than no color is unused.
- */
-size_t findSmallestUnusedColor(const std::vector<size_t>& neighbors,
-                               std::vector<bool>& neighboursColors,
-                               const ColoredGraph& graph) {
-  for (const auto& neighbourIndex : neighbors) {
-    if (graph[neighbourIndex].color() != graph.NO_COLOR)
-      neighboursColors[graph[neighbourIndex].color() - 1] = true;
-  }
-  size_t smallest = graph.NO_COLOR;
-  for (size_t i = 0; i < neighboursColors.size(); ++i) {
-    // find the smallest unused color
-    if (!neighboursColors[i]) {
-      smallest = graph.FIRST_COLOR + i;
-      break;
-    }
-  }
-  // clear
-  for (const auto& neighbourIndex : neighbors) {
-    if (graph[neighbourIndex].color() != graph.NO_COLOR)
-      neighboursColors[graph[neighbourIndex].color() - 1] = false;
-  }
-  return smallest;
-}
 
-void greedyColoring(ColoredGraph& graph,
+#include <random.h>
+#include "color_kernels.hpp"
+#include "trace.h"
+
+void greedyColoring(const Graph& graph,
+                    Coloring& coloring,
                     const std::vector<size_t> nodesPermut) {
+  GAL_TRACE_SPAN("greedy pass");
   auto iterNodes = nodesPermut.begin();
   if (iterNodes == nodesPermut.end())
     return;  // yeah, my work is done
 
-  std::vector<bool> neighboursColors(graph.size(), false);
-  graph[*iterNodes].color() = graph.FIRST_COLOR;
-  graph.colorCount() = 1;
+  // stamps need no clearing between nodes, see bench/color_kernels.cpp
+  StampColorKernel neighboursColors(graph.size());
+  coloring.color(*iterNodes) = Coloring::FIRST_COLOR;
+  coloring.colorCount() = 1;
 
   for (++iterNodes; iterNodes != nodesPermut.end(); ++iterNodes) {
     // find the smallest unused color
-    graph[*iterNodes].color() = findSmallestUnusedColor(
-        graph[*iterNodes].edges(), neighboursColors, graph);
-    if (graph[*iterNodes].color() > graph.colorCount())
+    coloring.color(*iterNodes) = neighboursColors.smallestUnused(
+        graph.neighbors(*iterNodes), coloring);
+    if (coloring.color(*iterNodes) > coloring.colorCount())
       // we have brand new color here
-      ++graph.colorCount();
+      ++coloring.colorCount();
   }
 }
 
-void greedyColoring(ColoredGraph& graph) {
+void greedyColoring(const Graph& graph, Coloring& coloring) {
   // we prepare data for more general function, that allows concrete node
-  std::vector<size_t> nodePerm;
-  nodePerm.reserve(graph.size());
-
-  std::transform(graph.begin(),
-                 graph.end(),
-                 std::back_inserter(nodePerm),
-                 [](const auto& n) { return n.id(); });
+  std::vector<size_t> nodePerm(graph.size());
+  std::iota(nodePerm.begin(), nodePerm.end(), 0);
 
-  greedyColoring(graph, nodePerm);
+  greedyColoring(graph, coloring, nodePerm);
 }
 
-void greedyColoringWithSet(ColoredGraph& graph) {
-  for (auto& n : graph) {
+void greedyColoringWithSet(const Graph& graph, Coloring& coloring) {
+  for (size_t n = 0; n < graph.size(); ++n) {
     std::set<size_t> neighboursColors;
-    for (const auto& neighbourIndex : n.edges())
-      neighboursColors.insert(graph[neighbourIndex].color());
+    for (const auto& neighbourIndex : graph.neighbors(n))
+      neighboursColors.insert(coloring.color(neighbourIndex));
 
     // instead of if in for loop we just remove NO_COLOR after
-    neighboursColors.erase(graph.NO_COLOR);
+    neighboursColors.erase(Coloring::NO_COLOR);
 
-    if (neighboursColors.size() < graph.colorCount()) {
+    if (neighboursColors.size() < coloring.colorCount()) {
       // we can recycle smallest unused color
-      size_t tryColor =
-          graph.FIRST_COLOR;  // we are starting with smallest possible color
+      // we are starting with smallest possible color
+      size_t tryColor = Coloring::FIRST_COLOR;
       for (size_t usedColor : neighboursColors) {
         // neighboursColors is order so we can check just difference
         if (usedColor - tryColor > 0) {
@@ -108,183 +74,453 @@ void greedyColoringWithSet(ColoredGraph& graph) {
           ++tryColor;
         }
       }
-      n.color() = tryColor;
+      coloring.color(n) = tryColor;
     } else {
       // ok, we need a new one
-      ++graph.colorCount();
-      n.color() = graph.colorCount();
+      ++coloring.colorCount();
+      coloring.color(n) = coloring.colorCount();
     }
   }
 }
 
-void largestDegreeOrderingColoring(ColoredGraph& graph) {
+size_t iteratedGreedy(const Graph& graph,
+                      Coloring& coloring,
+                      size_t maxIterations,
+                      std::chrono::steady_clock::duration timeLimit) {
+  using namespace std::chrono;
+  const auto start = steady_clock::now();
+  std::vector<size_t> classOrder;
+  std::vector<size_t> classStart;
+  std::vector<size_t> nodePerm(graph.size());
+
+  size_t iteration = 0;
+  for (; iteration < maxIterations; ++iteration) {
+    if (steady_clock::now() - start >= timeLimit)
+      break;
+
+    // counting sort of the nodes by their color
+    const size_t colorCount = coloring.colorCount();
+    classStart.assign(colorCount + 2, 0);
+    for (size_t i = 0; i < graph.size(); ++i)
+      ++classStart[coloring.color(i) + 1];
+    std::partial_sum(classStart.begin(), classStart.end(), classStart.begin());
+    auto classSize = [&](size_t color) {
+      return classStart[color + 1] - classStart[color];
+    };
+
+    classOrder.resize(colorCount);
+    std::iota(classOrder.begin(), classOrder.end(), Coloring::FIRST_COLOR);
+    switch (iteration % 3) {
+      case 0:
+        std::reverse(classOrder.begin(), classOrder.end());
+        break;
+      case 1:
+        std::stable_sort(classOrder.begin(),
+                         classOrder.end(),
+                         [&](size_t a, size_t b) {
+                           return classSize(a) > classSize(b);
+                         });
+        break;
+      default:
+        gal_thread_random().shuffle(classOrder.begin(), classOrder.end());
+    }
+
+    // positions of the classes in the new order
+    std::vector<size_t> position(colorCount + 1);
+    size_t next = 0;
+    for (auto color : classOrder) {
+      position[color] = next;
+      next += classSize(color);
+    }
+    for (size_t i = 0; i < graph.size(); ++i)
+      nodePerm[position[coloring.color(i)]++] = i;
+
+    coloring.clear();
+    greedyColoring(graph, coloring, nodePerm);
+  }
+  return iteration;
+}
+
+void largestDegreeOrderingColoring(const Graph& graph, Coloring& coloring) {
   std::vector<bool> colors(graph.size(), false);
 
   // Get nodes and their degree sorted in descending order according to their
   // degree.
   std::vector<std::pair<size_t, size_t>>
       nodeDeg;  // the pair is: node degree, node id
-  // get degree of each vertex
-  for (const auto& node : graph)
-    nodeDeg.push_back(std::make_pair(node.edges().size(), node.id()));
-
-  // sort DESC, because we are starting with the largest degree
-  std::sort(nodeDeg.begin(), nodeDeg.end(), std::greater<>());
-
   // this algorithm is same as greedy coloring but with defined permutation of
   // nodes
   std::vector<size_t> nodePerm;
-  nodePerm.reserve(nodeDeg.size());
-
-  std::transform(nodeDeg.begin(),
-                 nodeDeg.end(),
-                 std::back_inserter(nodePerm),
-                 [](const std::pair<size_t, size_t>& p) { return p.second; });
+  {
+    GAL_TRACE_SPAN("degree ordering");
+    // get degree of each vertex
+    for (size_t i = 0; i < graph.size(); ++i)
+      nodeDeg.push_back(std::make_pair(graph.degree(i), i));
+
+    // sort DESC, because we are starting with the largest degree
+    std::sort(nodeDeg.begin(), nodeDeg.end(), std::greater<>());
+
+    nodePerm.reserve(nodeDeg.size());
+    std::transform(nodeDeg.begin(),
+                   nodeDeg.end(),
+                   std::back_inserter(nodePerm),
+                   [](const std::pair<size_t, size_t>& p) { return p.second; });
+  }
 
-  greedyColoring(graph, nodePerm);
+  greedyColoring(graph, coloring, nodePerm);
 }
 
-void incidenceDegreeOrdering(ColoredGraph& graph) {
-  if (graph.size() == 0)
-    return;  // yeah, my work is done
+std::vector<size_t> smallestLastOrdering(const Graph& graph,
+                                         size_t& degeneracy) {
+  GAL_TRACE_SPAN("smallest last ordering");
+  constexpr size_t NONE = std::numeric_limits<size_t>::max();
+  const size_t n = graph.size();
+  // nodes not removed yet in linked lists by their remaining degree
+  std::vector<size_t> degree(n);
+  std::vector<size_t> next(n);
+  std::vector<size_t> prev(n);
+  std::vector<bool> removed(n, false);
+  size_t maxDegree = 0;
+  for (size_t i = 0; i < n; ++i) {
+    degree[i] = graph.degree(i);
+    maxDegree = std::max(maxDegree, degree[i]);
+  }
+  std::vector<size_t> head(maxDegree + 1, NONE);
+  auto link = [&](size_t node) {
+    size_t& first = head[degree[node]];
+    next[node] = first;
+    prev[node] = NONE;
+    if (first != NONE)
+      prev[first] = node;
+    first = node;
+  };
+  auto unlink = [&](size_t node) {
+    if (prev[node] == NONE)
+      head[degree[node]] = next[node];
+    else
+      next[prev[node]] = next[node];
+    if (next[node] != NONE)
+      prev[next[node]] = prev[node];
+  };
+  for (size_t i = n; i-- > 0;) {
+    link(i);
+  }
 
-  // create set with not colored nodes
-  std::unordered_set<size_t> notColoredNodes;
-  notColoredNodes.reserve(graph.size());
+  std::vector<size_t> order(n);
+  degeneracy = 0;
+  size_t minDegree = 0;
+  // the node removed first is colored last
+  for (size_t i = n; i-- > 0;) {
+    while (head[minDegree] == NONE)
+      ++minDegree;
+    size_t node = head[minDegree];
+    unlink(node);
+    removed[node] = true;
+    order[i] = node;
+    degeneracy = std::max(degeneracy, minDegree);
+
+    for (const auto& neighbor : graph.neighbors(node)) {
+      if (!removed[neighbor]) {
+        unlink(neighbor);
+        --degree[neighbor];
+        link(neighbor);
+      }
+    }
+    // the smallest degree dropped by one at most
+    if (minDegree > 0)
+      --minDegree;
+  }
+  return order;
+}
 
-  std::vector<size_t> numberOfColoredNeighbors(graph.size(), 0);
+size_t degeneracy(const Graph& graph) {
+  size_t result = 0;
+  smallestLastOrdering(graph, result);
+  return result;
+}
 
-  // map Node -> degree
-  // + selecting of max degree node
+void smallestLastColoring(const Graph& graph, Coloring& coloring) {
+  size_t degeneracy = 0;
+  greedyColoring(graph, coloring, smallestLastOrdering(graph, degeneracy));
+}
 
-  std::vector<size_t> nodeDeg(graph.size());
-  size_t maxDegreeNode = 0;
-  size_t maxDegree = 0;
+namespace {
 
-  for (const auto& node : graph) {
-    notColoredNodes.insert(node.id());
-    size_t degree = node.edges().size();
-    nodeDeg[node.id()] = degree;
-    if (degree > maxDegree) {
-      maxDegreeNode = node.id();
-      maxDegree = degree;
+/**
+ * Priority queue of uncolored nodes keyed by a level, which starts at 0, only
+ * grows by one and never exceeds the degree of the node, like the number of
+ * colored neighbors (incidence degree) or of their distinct colors
+ * (saturation degree). The top is a node with the highest level and among
+ * those the one with the largest degree.
+ *
+ * Nodes are kept in linked lists, one for each level and degree class, where
+ * degree classes are the distinct degrees ranked from the largest one. Level
+ * k needs lists only for the classes with degree >= k, so all levels
+ * together have at most n + 2m lists. Every level has a bitset of nonempty
+ * lists with a summary word per 64 words, so the top of a level is found by
+ * scanning one word per 4096 degree classes. The top level is tracked with a
+ * pointer, so n pops and m increments take O(n + m) for graphs with up to
+ * 4096 distinct degrees.
+ */
+class DegreeBucketQueue {
+ public:
+  explicit DegreeBucketQueue(const Graph& graph)
+      : level_(graph.size(), 0),
+        degreeClass_(graph.size()),
+        next_(graph.size()),
+        prev_(graph.size()),
+        queued_(graph.size(), true) {
+    size_t maxDegree = 0;
+    for (size_t i = 0; i < graph.size(); ++i) {
+      maxDegree = std::max(maxDegree, graph.degree(i));
+    }
+    // rank the distinct degrees from the largest one
+    std::vector<size_t> rank(maxDegree + 1, NONE);
+    for (size_t i = 0; i < graph.size(); ++i) {
+      rank[graph.degree(i)] = 0;
+    }
+    std::vector<size_t> classDegree;
+    for (size_t d = maxDegree + 1; d-- > 0;) {
+      if (rank[d] == 0) {
+        rank[d] = classDegree.size();
+        classDegree.push_back(d);
+      }
+    }
+    for (size_t i = 0; i < graph.size(); ++i) {
+      degreeClass_[i] = rank[graph.degree(i)];
     }
-  }
-
-  // set color to max degree node
-  graph[maxDegreeNode].color() = graph.FIRST_COLOR;
-  graph.colorCount() = 1;
 
-  // delete the colored one
-  notColoredNodes.erase(maxDegreeNode);
-  // update neighbors colors
-  for (const auto& edge : graph[maxDegreeNode].edges())
-    ++numberOfColoredNeighbors[edge];
+    // level k holds classes <0, classes) with degree >= k
+    const size_t levels = maxDegree + 1;
+    cellStart_.resize(levels + 1, 0);
+    wordStart_.resize(levels + 1, 0);
+    summaryStart_.resize(levels + 1, 0);
+    levelSize_.assign(levels, 0);
+    size_t classes = classDegree.size();
+    for (size_t k = 0; k < levels; ++k) {
+      while (classes > 0 && classDegree[classes - 1] < k) {
+        --classes;
+      }
+      size_t words = (classes + 63) / 64;
+      cellStart_[k + 1] = cellStart_[k] + classes;
+      wordStart_[k + 1] = wordStart_[k] + words;
+      summaryStart_[k + 1] = summaryStart_[k] + (words + 63) / 64;
+    }
+    head_.assign(cellStart_[levels], NONE);
+    words_.assign(wordStart_[levels], 0);
+    summary_.assign(summaryStart_[levels], 0);
 
-  std::vector<bool> neighboursColors(graph.size(), false);
+    // insert in reverse, so that equal nodes come out in the order of ids
+    for (size_t i = graph.size(); i-- > 0;) {
+      insert(i);
+    }
+    size_ = graph.size();
+  }
 
-  while (notColoredNodes.size() > 0) {
-    // find node with greatest number of colored neighbors
+  bool empty() const noexcept { return size_ == 0; }
 
-    auto iterNode = notColoredNodes.cbegin();
-    size_t theChosenOne = *iterNode;
+  bool contains(size_t node) const noexcept { return queued_[node]; }
 
-    size_t theChosenOneColoredNeighborsCnt =
-        numberOfColoredNeighbors[*iterNode];
+  /**
+   * Removes and returns the top node.
+   */
+  size_t pop() {
+    while (levelSize_[top_] == 0) {
+      --top_;
+    }
+    size_t s = summaryStart_[top_];
+    while (summary_[s] == 0) {
+      ++s;
+    }
+    size_t word = (s - summaryStart_[top_]) * 64 + __builtin_ctzll(summary_[s]);
+    size_t degreeClass =
+        word * 64 + __builtin_ctzll(words_[wordStart_[top_] + word]);
+    size_t node = head_[cellStart_[top_] + degreeClass];
+    remove(node);
+    queued_[node] = false;
+    --size_;
+    return node;
+  }
 
-    for (++iterNode; iterNode != notColoredNodes.cend(); ++iterNode) {
-      if (numberOfColoredNeighbors[*iterNode] >
-          theChosenOneColoredNeighborsCnt) {
-        // actual node has more colored neighbors
-        theChosenOne = *iterNode;
-        theChosenOneColoredNeighborsCnt = numberOfColoredNeighbors[*iterNode];
+  /**
+   * Raises the level of a node in the queue by one.
+   */
+  void increment(size_t node) {
+    remove(node);
+    ++level_[node];
+    insert(node);
+  }
 
-      } else if (numberOfColoredNeighbors[*iterNode] ==
-                     theChosenOneColoredNeighborsCnt &&
-                 nodeDeg[*iterNode] > nodeDeg[theChosenOne]) {
-        // actual node has same number of colored neighbors, but have bigger
-        // degree
-        theChosenOne = *iterNode;
+ private:
+  static constexpr size_t NONE = std::numeric_limits<size_t>::max();
+
+  void insert(size_t node) {
+    size_t level = level_[node];
+    size_t degreeClass = degreeClass_[node];
+    size_t& head = head_[cellStart_[level] + degreeClass];
+    if (head == NONE) {
+      uint64_t& word = words_[wordStart_[level] + degreeClass / 64];
+      if (word == 0) {
+        summary_[summaryStart_[level] + degreeClass / 4096] |=
+            uint64_t{1} << (degreeClass / 64 % 64);
       }
+      word |= uint64_t{1} << (degreeClass % 64);
+    } else {
+      prev_[head] = node;
     }
+    next_[node] = head;
+    prev_[node] = NONE;
+    head = node;
+    ++levelSize_[level];
+    top_ = std::max(top_, level);
+  }
 
-    // we have chosen node
-    // now is time to try color
-
-    graph[theChosenOne].color() = findSmallestUnusedColor(
-        graph[theChosenOne].edges(), neighboursColors, graph);
+  void remove(size_t node) {
+    size_t level = level_[node];
+    size_t degreeClass = degreeClass_[node];
+    size_t& head = head_[cellStart_[level] + degreeClass];
+    if (prev_[node] == NONE) {
+      head = next_[node];
+    } else {
+      next_[prev_[node]] = next_[node];
+    }
+    if (next_[node] != NONE) {
+      prev_[next_[node]] = prev_[node];
+    }
+    if (head == NONE) {
+      uint64_t& word = words_[wordStart_[level] + degreeClass / 64];
+      word &= ~(uint64_t{1} << (degreeClass % 64));
+      if (word == 0) {
+        summary_[summaryStart_[level] + degreeClass / 4096] &=
+            ~(uint64_t{1} << (degreeClass / 64 % 64));
+      }
+    }
+    --levelSize_[level];
+  }
 
-    if (graph[theChosenOne].color() > graph.colorCount())
+  std::vector<size_t> level_;
+  std::vector<size_t> degreeClass_;
+  std::vector<size_t> next_;
+  std::vector<size_t> prev_;
+  std::vector<bool> queued_;
+  // per level offsets to head_, words_ and summary_
+  std::vector<size_t> cellStart_;
+  std::vector<size_t> wordStart_;
+  std::vector<size_t> summaryStart_;
+  std::vector<size_t> head_;
+  std::vector<uint64_t> words_;
+  std::vector<uint64_t> summary_;
+  std::vector<size_t> levelSize_;
+  size_t top_ = 0;
+  size_t size_ = 0;
+};
+
+}  // namespace
+
+void incidenceDegreeOrdering(const Graph& graph, Coloring& coloring) {
+  DegreeBucketQueue queue(graph);
+  StampColorKernel neighboursColors(graph.size());
+
+  coloring.colorCount() = 0;
+  while (!queue.empty()) {
+    // the node with the most colored neighbors, the largest degree first
+    size_t theChosenOne = queue.pop();
+
+    coloring.color(theChosenOne) = neighboursColors.smallestUnused(
+        graph.neighbors(theChosenOne), coloring);
+
+    if (coloring.color(theChosenOne) > coloring.colorCount())
       // we have brand new color here
-      ++graph.colorCount();
+      ++coloring.colorCount();
 
-    // ok, the node is now colored
-    notColoredNodes.erase(theChosenOne);
-    // update neighbors colors
-    for (const auto& edge : graph[maxDegreeNode].edges())
-      ++numberOfColoredNeighbors[edge];
+    // update neighbors of the colored node
+    for (const auto& neighbor : graph.neighbors(theChosenOne)) {
+      if (queue.contains(neighbor))
+        queue.increment(neighbor);
+    }
   }
 }
 
-int saturationDegree(const ColoredGraph& graph, size_t node) {
-  static std::unordered_set<size_t> usedColors;
-  for (auto&& neighbor : graph[node].edges()) {
-    usedColors.insert(graph[neighbor].color());
+namespace {
+
+/**
+ * The colors seen among the neighbors of each node.
+ *
+ * A node of degree d never needs a color above d + 1, so the colors up to
+ * d + 1 are kept in a flat bitset of d + 1 bits rounded up to whole words
+ * per node, O(n + m) bits for the whole graph. Larger colors only count
+ * towards the saturation degree and are rare, they are kept in a set.
+ */
+class NeighborColors {
+ public:
+  explicit NeighborColors(const Graph& graph)
+      : wordStart_(graph.size() + 1, 0) {
+    for (size_t i = 0; i < graph.size(); ++i) {
+      wordStart_[i + 1] = wordStart_[i] + (graph.degree(i) + 1 + 63) / 64;
+    }
+    words_.assign(wordStart_.back(), 0);
   }
-  usedColors.erase(graph.NO_COLOR);
-  int degree = usedColors.size();
-  usedColors.clear();
-  return degree;
-}
 
-void sdoLdoColoring(ColoredGraph& graph) {
-  std::vector<bool> colorVec(graph.size(), false);
-  std::vector<size_t> remainingNodes(graph.size(), 0);
-  // stored saturation degrees
-  std::vector<int> satDegrees(graph.size(), 0);
-  std::set<size_t> updateSaturation;
-  for (auto&& node : graph) {
-    satDegrees[node.id()] = saturationDegree(graph, node.id());
+  /**
+   * Marks a neighbor color of the node.
+   *
+   * @return True when the node had no neighbor with the color yet.
+   */
+  bool insert(size_t node, size_t color) {
+    size_t bit = color - Coloring::FIRST_COLOR;
+    if (bit >= (wordStart_[node + 1] - wordStart_[node]) * 64) {
+      return highColors_.emplace(node, color).second;
+    }
+    uint64_t& word = words_[wordStart_[node] + bit / 64];
+    uint64_t mask = uint64_t{1} << (bit % 64);
+    bool inserted = (word & mask) == 0;
+    word |= mask;
+    return inserted;
   }
-  std::iota(remainingNodes.begin(), remainingNodes.end(), 0);
-  while (!remainingNodes.empty()) {
-    size_t selectedNode = 0;
-    size_t index = 0;
-    int maxSaturation = -1;
-
-    // select node to color
-    for (size_t i = 0; i < remainingNodes.size(); ++i) {
-      size_t node = remainingNodes[i];
-      // only update saturation degree if necessary
-      if (updateSaturation.count(node)) {
-        satDegrees[node] = saturationDegree(graph, node);
-      }
-      int saturation = satDegrees[node];
-      if (saturation > maxSaturation) {
-        maxSaturation = saturation;
-        index = i;
-        selectedNode = remainingNodes[i];
-      } else if (saturation == maxSaturation &&
-                 graph[node].edges().size() >
-                     graph[selectedNode].edges().size()) {
-        index = i;
-        selectedNode = remainingNodes[i];
-      }
+
+  /**
+   * The smallest color none of the neighbors of the node has.
+   */
+  size_t smallestUnused(size_t node) const {
+    // the last word always has a zero bit past the degree of the node
+    size_t i = wordStart_[node];
+    while (words_[i] == ~uint64_t{0}) {
+      ++i;
     }
-    // color node
-    graph[selectedNode].color() =
-        findSmallestUnusedColor(graph[selectedNode].edges(), colorVec, graph);
+    return Coloring::FIRST_COLOR + (i - wordStart_[node]) * 64 +
+           __builtin_ctzll(~words_[i]);
+  }
+
+ private:
+  std::vector<size_t> wordStart_;
+  std::vector<uint64_t> words_;
+  std::set<std::pair<size_t, size_t>> highColors_;
+};
 
-    if (graph[selectedNode].color() > graph.colorCount()) {
+}  // namespace
+
+void sdoLdoColoring(const Graph& graph, Coloring& coloring) {
+  NeighborColors neighborColors(graph);
+  // keyed by saturation degree
+  DegreeBucketQueue queue(graph);
+
+  coloring.colorCount() = 0;
+  while (!queue.empty()) {
+    // the node with the most distinct neighbor colors, the largest degree first
+    size_t selectedNode = queue.pop();
+
+    // color node
+    size_t color = neighborColors.smallestUnused(selectedNode);
+    coloring.color(selectedNode) = color;
+    if (color > coloring.colorCount()) {
       // we have brand new color here
-      ++graph.colorCount();
+      ++coloring.colorCount();
+    }
+    // update saturation degrees of the neighbors
+    for (auto&& neighbor : graph.neighbors(selectedNode)) {
+      if (queue.contains(neighbor) && neighborColors.insert(neighbor, color))
+        queue.increment(neighbor);
     }
-    // set updateSaturation
-    auto&& edges = graph[selectedNode].edges();
-    updateSaturation = {edges.begin(), edges.end()};
-    // remove selected from remaining
-    std::swap(remainingNodes[index], remainingNodes.back());
-    remainingNodes.pop_back();
   }
 }
 
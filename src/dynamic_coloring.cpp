@@ -0,0 +1,261 @@
+/**
+ * Project: gal
+ * @file dynamic_coloring.cpp
+ * @date 17. 10. 2026
+ * @author xvitra00, xdocek09
+ * @brief Source file of module maintaining a coloring of a changing graph.
+ */
+
+#include "dynamic_coloring.h"
+
+#include <algorithm>
+#include <stdexcept>
+
+DynamicColoring::DynamicColoring(const Graph& graph,
+                                 const Coloring& coloring,
+                                 bool localRecoloring)
+    : adjacency_(graph.size()),
+      colors_(graph.size(), Coloring::NO_COLOR),
+      alive_(graph.size(), true),
+      classSize_(1, 0),
+      kernel_(graph.size()),
+      localRecoloring_(localRecoloring) {
+  if (coloring.size() != graph.size()) {
+    throw std::invalid_argument("Coloring does not match the graph.");
+  }
+  for (size_t i = 0; i < graph.size(); ++i) {
+    // the color kernel has room for colors up to the number of nodes
+    if (coloring.color(i) > graph.size()) {
+      throw std::invalid_argument("Color out of range in the coloring.");
+    }
+  }
+  for (size_t i = 0; i < graph.size(); ++i) {
+    auto&& edges = graph.neighbors(i);
+    adjacency_[i].assign(edges.begin(), edges.end());
+    setColor(i, coloring.color(i));
+  }
+  // a recolored node is valid, so each conflict is repaired once
+  for (size_t i = 0; i < graph.size(); ++i) {
+    bool conflict = colors_[i] == Coloring::NO_COLOR;
+    for (size_t j = 0; !conflict && j < adjacency_[i].size(); ++j) {
+      conflict = colors_[adjacency_[i][j]] == colors_[i];
+    }
+    if (conflict) {
+      repair(i);
+    }
+  }
+}
+
+void DynamicColoring::insertEdge(size_t a, size_t b) {
+  checkNode(a);
+  checkNode(b);
+  if (link(a, b) && colors_[a] == colors_[b]) {
+    repair(adjacency_[a].size() < adjacency_[b].size() ? a : b);
+  }
+}
+
+void DynamicColoring::removeEdge(size_t a, size_t b) {
+  checkNode(a);
+  checkNode(b);
+  if (unlink(a, b) && localRecoloring_) {
+    lower(a);
+    lower(b);
+  }
+}
+
+size_t DynamicColoring::addNode() {
+  size_t node;
+  if (freeIds_.empty()) {
+    node = adjacency_.size();
+    adjacency_.emplace_back();
+    colors_.push_back(Coloring::NO_COLOR);
+    alive_.push_back(true);
+    kernel_.resize(adjacency_.size());
+  } else {
+    node = freeIds_.back();
+    freeIds_.pop_back();
+    alive_[node] = true;
+  }
+  setColor(node, Coloring::FIRST_COLOR);
+  return node;
+}
+
+void DynamicColoring::removeNode(size_t node) {
+  checkNode(node);
+  std::vector<size_t> touched;
+  removeNodeEdges(node, touched);
+  if (localRecoloring_) {
+    for (auto neighbor : touched) {
+      lower(neighbor);
+    }
+  }
+}
+
+std::vector<size_t> DynamicColoring::apply(const std::vector<Update>& updates) {
+  std::vector<size_t> created;
+  std::vector<size_t> conflicts;
+  std::vector<size_t> touched;
+  for (auto&& update : updates) {
+    switch (update.type) {
+      case Update::INSERT_EDGE:
+        checkNode(update.a);
+        checkNode(update.b);
+        if (link(update.a, update.b) &&
+            colors_[update.a] == colors_[update.b]) {
+          conflicts.push_back(update.a);
+          conflicts.push_back(update.b);
+        }
+        break;
+      case Update::REMOVE_EDGE:
+        checkNode(update.a);
+        checkNode(update.b);
+        if (unlink(update.a, update.b)) {
+          touched.push_back(update.a);
+          touched.push_back(update.b);
+        }
+        break;
+      case Update::ADD_NODE:
+        created.push_back(addNode());
+        break;
+      case Update::REMOVE_NODE:
+        checkNode(update.a);
+        removeNodeEdges(update.a, touched);
+        break;
+    }
+  }
+
+  // a conflict may be gone by the time its node comes, e.g. after the other
+  // endpoint was recolored
+  std::sort(conflicts.begin(), conflicts.end(), [&](size_t a, size_t b) {
+    return adjacency_[a].size() > adjacency_[b].size() ||
+           (adjacency_[a].size() == adjacency_[b].size() && a < b);
+  });
+  conflicts.erase(std::unique(conflicts.begin(), conflicts.end()),
+                  conflicts.end());
+  for (auto node : conflicts) {
+    if (!alive_[node]) {
+      continue;
+    }
+    for (auto neighbor : adjacency_[node]) {
+      if (colors_[neighbor] == colors_[node]) {
+        repair(node);
+        break;
+      }
+    }
+  }
+  if (localRecoloring_) {
+    for (auto node : touched) {
+      if (alive_[node]) {
+        lower(node);
+      }
+    }
+  }
+  return created;
+}
+
+bool DynamicColoring::hasEdge(size_t a, size_t b) const {
+  if (!contains(a) || !contains(b)) {
+    return false;
+  }
+  // scan the shorter list
+  if (adjacency_[a].size() > adjacency_[b].size()) {
+    std::swap(a, b);
+  }
+  auto&& edges = adjacency_[a];
+  return std::find(edges.begin(), edges.end(), b) != edges.end();
+}
+
+ColoredGraph DynamicColoring::graph() const {
+  std::vector<size_t> offsets(1, 0);
+  std::vector<size_t> adjacency;
+  offsets.reserve(size() + 1);
+  for (auto&& edges : adjacency_) {
+    adjacency.insert(adjacency.end(), edges.begin(), edges.end());
+    offsets.push_back(adjacency.size());
+  }
+  ColoredGraph result(Graph(offsets, adjacency));
+  result.colorCount() = colorCount();
+  for (size_t i = 0; i < size(); ++i) {
+    result.color(i) = alive_[i] ? colors_[i] : Coloring::FIRST_COLOR;
+    result.colorCount() = std::max(result.colorCount(), result.color(i));
+  }
+  return result;
+}
+
+void DynamicColoring::checkNode(size_t node) const {
+  if (!contains(node)) {
+    throw std::invalid_argument("Node does not exist.");
+  }
+}
+
+bool DynamicColoring::link(size_t a, size_t b) {
+  if (a == b || hasEdge(a, b)) {
+    return false;
+  }
+  adjacency_[a].push_back(b);
+  adjacency_[b].push_back(a);
+  return true;
+}
+
+bool DynamicColoring::unlink(size_t a, size_t b) {
+  auto erase = [&](size_t from, size_t node) {
+    auto&& edges = adjacency_[from];
+    auto it = std::find(edges.begin(), edges.end(), node);
+    if (it == edges.end()) {
+      return false;
+    }
+    *it = edges.back();
+    edges.pop_back();
+    return true;
+  };
+  return erase(a, b) && erase(b, a);
+}
+
+void DynamicColoring::setColor(size_t node, size_t color) {
+  if (colors_[node] != Coloring::NO_COLOR) {
+    --classSize_[colors_[node]];
+  }
+  colors_[node] = color;
+  if (color != Coloring::NO_COLOR) {
+    if (classSize_.size() <= color) {
+      classSize_.resize(color + 1, 0);
+    }
+    ++classSize_[color];
+  }
+  while (classSize_.size() > 1 && classSize_.back() == 0) {
+    classSize_.pop_back();
+  }
+}
+
+size_t DynamicColoring::freeColor(size_t node) {
+  return kernel_.smallestUnusedOf(neighbors(node),
+                                  [&](size_t other) { return colors_[other]; });
+}
+
+void DynamicColoring::repair(size_t node) {
+  setColor(node, freeColor(node));
+}
+
+void DynamicColoring::lower(size_t node) {
+  size_t color = freeColor(node);
+  if (color < colors_[node]) {
+    setColor(node, color);
+  }
+}
+
+void DynamicColoring::removeNodeEdges(size_t node,
+                                      std::vector<size_t>& touched) {
+  for (auto neighbor : adjacency_[node]) {
+    auto&& edges = adjacency_[neighbor];
+    auto it = std::find(edges.begin(), edges.end(), node);
+    *it = edges.back();
+    edges.pop_back();
+    touched.push_back(neighbor);
+  }
+  adjacency_[node].clear();
+  setColor(node, Coloring::NO_COLOR);
+  alive_[node] = false;
+  freeIds_.push_back(node);
+}
+
+/*** End of file: dynamic_coloring.cpp ***/
@@ -0,0 +1,321 @@
+/**
+ * Project: gal
+ * @file exact_coloring.cpp
+ * @date 17. 10. 2026
+ * @author xvitra00, xdocek09
+ * @brief Source file of module computing optimal colorings of small graphs.
+ */
+
+#include "exact_coloring.h"
+
+#include <algorithm>
+#include <cstdint>
+#include <utility>
+#include <vector>
+
+#include "coloring_alg.h"
+
+namespace {
+
+using Clock = std::chrono::steady_clock;
+
+// search nodes between two looks at the clock
+constexpr size_t CLOCK_INTERVAL = 1024;
+
+inline bool testBit(const uint64_t* words, size_t bit) noexcept {
+  return (words[bit / 64] >> (bit % 64)) & 1;
+}
+
+template <typename F>
+inline void forEachBit(uint64_t word, size_t base, F&& f) {
+  while (word != 0) {
+    f(base + __builtin_ctzll(word));
+    word &= word - 1;
+  }
+}
+
+/**
+ * Adjacency matrix with one bitset row per node.
+ */
+class BitRows {
+ public:
+  explicit BitRows(const Graph& graph)
+      : size_(graph.size()),
+        words_((graph.size() + 63) / 64),
+        bits_(size_ * words_, 0) {
+    for (size_t i = 0; i < size_; ++i) {
+      uint64_t* row = bits_.data() + i * words_;
+      for (auto neighbor : graph.neighbors(i)) {
+        row[neighbor / 64] |= uint64_t{1} << (neighbor % 64);
+      }
+    }
+  }
+
+  size_t size() const noexcept { return size_; }
+  size_t words() const noexcept { return words_; }
+  const uint64_t* row(size_t i) const noexcept {
+    return bits_.data() + i * words_;
+  }
+
+ private:
+  size_t size_;
+  size_t words_;
+  std::vector<uint64_t> bits_;
+};
+
+std::vector<size_t> greedyClique(const BitRows& rows) {
+  const size_t words = rows.words();
+  std::vector<size_t> best;
+  std::vector<size_t> clique;
+  std::vector<uint64_t> candidates(words);
+  for (size_t start = 0; start < rows.size(); ++start) {
+    clique.assign(1, start);
+    std::copy_n(rows.row(start), words, candidates.begin());
+    while (true) {
+      // the candidate adjacent to the most other candidates
+      size_t next = rows.size();
+      size_t nextDegree = 0;
+      for (size_t w = 0; w < words; ++w) {
+        forEachBit(candidates[w], w * 64, [&](size_t node) {
+          const uint64_t* row = rows.row(node);
+          size_t degree = 0;
+          for (size_t i = 0; i < words; ++i) {
+            degree += __builtin_popcountll(row[i] & candidates[i]);
+          }
+          if (next == rows.size() || degree > nextDegree) {
+            next = node;
+            nextDegree = degree;
+          }
+        });
+      }
+      if (next == rows.size()) {
+        break;
+      }
+      clique.push_back(next);
+      const uint64_t* row = rows.row(next);
+      for (size_t w = 0; w < words; ++w) {
+        candidates[w] &= row[w];
+      }
+    }
+    if (clique.size() > best.size()) {
+      best.swap(clique);
+    }
+  }
+  return best;
+}
+
+/**
+ * DSatur branch and bound over bitset rows.
+ */
+class ExactSolver {
+ public:
+  ExactSolver(const BitRows& rows,
+              std::vector<size_t> upperColors,
+              size_t upperCount,
+              size_t lowerBound,
+              size_t nodeLimit,
+              Clock::time_point deadline)
+      : rows_(rows),
+        words_(rows.words()),
+        uncolored_(words_, 0),
+        forbidden_((upperCount + 1) * words_, 0),
+        saturation_(rows.size(), 0),
+        colors_(rows.size(), Coloring::NO_COLOR),
+        undo_(rows.size() * 2 * words_),
+        best_(std::move(upperColors)),
+        bestCount_(upperCount),
+        lowerBound_(lowerBound),
+        nodeLimit_(nodeLimit),
+        deadline_(deadline) {
+    for (size_t i = 0; i < rows.size(); ++i) {
+      uncolored_[i / 64] |= uint64_t{1} << (i % 64);
+    }
+  }
+
+  /**
+   * Colors the clique 1 ... k and searches the rest.
+   */
+  void run(const std::vector<size_t>& clique) {
+    for (size_t i = 0; i < clique.size(); ++i) {
+      assign(clique[i], i + 1, nullptr);
+    }
+    if (bestCount_ > lowerBound_) {
+      search(0, clique.size());
+    }
+  }
+
+  const std::vector<size_t>& best() const noexcept { return best_; }
+  size_t bestCount() const noexcept { return bestCount_; }
+  bool stopped() const noexcept { return stopped_; }
+  size_t nodes() const noexcept { return nodes_; }
+
+ private:
+  uint64_t* forbidden(size_t color) noexcept {
+    return forbidden_.data() + color * words_;
+  }
+
+  /**
+   * Colors a node. The neighbors that could still take the color lose it and
+   * their saturation grows. With undo, the previous state of the color row
+   * and the neighbors that lost the color are saved for unassign().
+   */
+  void assign(size_t node, size_t color, uint64_t* undo) {
+    uint64_t* row = forbidden(color);
+    const uint64_t* adjacent = rows_.row(node);
+    colors_[node] = color;
+    uncolored_[node / 64] &= ~(uint64_t{1} << (node % 64));
+    for (size_t w = 0; w < words_; ++w) {
+      uint64_t lost = adjacent[w] & ~row[w] & uncolored_[w];
+      if (undo != nullptr) {
+        undo[w] = row[w];
+        undo[words_ + w] = lost;
+      }
+      forEachBit(lost, w * 64, [&](size_t other) { ++saturation_[other]; });
+      row[w] |= adjacent[w];
+    }
+  }
+
+  void unassign(size_t node, size_t color, const uint64_t* undo) {
+    uint64_t* row = forbidden(color);
+    for (size_t w = 0; w < words_; ++w) {
+      forEachBit(undo[words_ + w], w * 64,
+                 [&](size_t other) { --saturation_[other]; });
+      row[w] = undo[w];
+    }
+    uncolored_[node / 64] |= uint64_t{1} << (node % 64);
+    colors_[node] = Coloring::NO_COLOR;
+  }
+
+  /**
+   * The uncolored node with the highest saturation, ties are broken by the
+   * number of uncolored neighbors. Returns size() when all are colored.
+   */
+  size_t select() const {
+    size_t best = rows_.size();
+    size_t bestSaturation = 0;
+    size_t bestDegree = 0;
+    for (size_t w = 0; w < words_; ++w) {
+      forEachBit(uncolored_[w], w * 64, [&](size_t node) {
+        if (best != rows_.size() && saturation_[node] < bestSaturation) {
+          return;
+        }
+        const uint64_t* adjacent = rows_.row(node);
+        size_t degree = 0;
+        for (size_t i = 0; i < words_; ++i) {
+          degree += __builtin_popcountll(adjacent[i] & uncolored_[i]);
+        }
+        if (best == rows_.size() || saturation_[node] > bestSaturation ||
+            degree > bestDegree) {
+          best = node;
+          bestSaturation = saturation_[node];
+          bestDegree = degree;
+        }
+      });
+    }
+    return best;
+  }
+
+  void search(size_t depth, size_t usedColors) {
+    ++nodes_;
+    if (nodes_ > nodeLimit_ ||
+        (nodes_ % CLOCK_INTERVAL == 0 && Clock::now() > deadline_)) {
+      stopped_ = true;
+      return;
+    }
+    size_t node = select();
+    if (node == rows_.size()) {
+      // a complete coloring, better than the best one or it would be pruned
+      best_ = colors_;
+      bestCount_ = usedColors;
+      return;
+    }
+
+    uint64_t* undo = undo_.data() + depth * 2 * words_;
+    for (size_t color = Coloring::FIRST_COLOR;
+         color <= usedColors && color < bestCount_; ++color) {
+      if (testBit(forbidden(color), node)) {
+        continue;
+      }
+      assign(node, color, undo);
+      search(depth + 1, usedColors);
+      unassign(node, color, undo);
+      if (stopped_ || bestCount_ == lowerBound_) {
+        return;
+      }
+    }
+    // a new color only while it still beats the best coloring
+    if (usedColors + 1 < bestCount_) {
+      assign(node, usedColors + 1, undo);
+      search(depth + 1, usedColors + 1);
+      unassign(node, usedColors + 1, undo);
+    }
+  }
+
+  const BitRows& rows_;
+  const size_t words_;
+  std::vector<uint64_t> uncolored_;
+  // bit i of the row of color c: node i has a neighbor of color c
+  std::vector<uint64_t> forbidden_;
+  // the number of distinct colors of the neighbors
+  std::vector<size_t> saturation_;
+  std::vector<size_t> colors_;
+  // two rows per search depth, see assign()
+  std::vector<uint64_t> undo_;
+  std::vector<size_t> best_;
+  size_t bestCount_;
+  size_t lowerBound_;
+  size_t nodeLimit_;
+  Clock::time_point deadline_;
+  size_t nodes_ = 0;
+  bool stopped_ = false;
+};
+
+}  // namespace
+
+size_t greedyCliqueSize(const Graph& graph) {
+  return greedyClique(BitRows(graph)).size();
+}
+
+ExactColoringResult exactColoring(const Graph& graph,
+                                  Coloring& coloring,
+                                  size_t nodeLimit,
+                                  Clock::duration timeLimit) {
+  auto start = Clock::now();
+  auto deadline = timeLimit >= Clock::time_point::max() - start
+                      ? Clock::time_point::max()
+                      : start + timeLimit;
+  ExactColoringResult result;
+  if (graph.size() == 0) {
+    coloring.colorCount() = 0;
+    result.optimal = true;
+    return result;
+  }
+
+  // the upper bound from the heuristics
+  Coloring upper(graph.size());
+  sdoLdoColoring(graph, upper);
+  Coloring other(graph.size());
+  smallestLastColoring(graph, other);
+  if (other.colorCount() < upper.colorCount()) {
+    upper = std::move(other);
+  }
+  iteratedGreedy(graph, upper, 100, timeLimit / 10);
+
+  BitRows rows(graph);
+  auto clique = greedyClique(rows);
+  ExactSolver solver(rows, upper.colors(), upper.colorCount(), clique.size(),
+                     nodeLimit, deadline);
+  solver.run(clique);
+
+  for (size_t i = 0; i < graph.size(); ++i) {
+    coloring.color(i) = solver.best()[i];
+  }
+  coloring.colorCount() = solver.bestCount();
+  result.colorCount = solver.bestCount();
+  result.optimal = !solver.stopped();
+  result.lowerBound = result.optimal ? result.colorCount : clique.size();
+  result.searchNodes = solver.nodes();
+  return result;
+}
+
+/*** End of file: exact_coloring.cpp ***/
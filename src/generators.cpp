@@ -0,0 +1,609 @@
+/**
+ * Project: gal
+ * @file generators.cpp
+ * @date 17. 10. 2026
+ * @author xvitra00, xdocek09
+ * @brief Source file of module containing random graph generators.
+ */
+
+#include "generators.h"
+
+#include <algorithm>
+#include <charconv>
+#include <cmath>
+#include <cstdint>
+#include <ostream>
+#include <stdexcept>
+#include <vector>
+
+#include <random.h>
+#include "parallel.hpp"
+
+namespace {
+
+/**
+ * Edges of the rows <first, last) of the lower triangle of the adjacency
+ * matrix.
+ */
+struct RowBlock {
+  size_t first = 0;
+  size_t last = 0;
+  // rowEnds[i] is the number of targets up to and including row first + i
+  std::vector<size_t> rowEnds;
+  std::vector<size_t> targets;
+};
+
+/**
+ * Uniform numbers generated in batches.
+ */
+class UniformBuffer {
+ public:
+  explicit UniformBuffer(GalRandom& engine) : engine_(engine) {}
+
+  double operator()() {
+    if (next_ == BATCH) {
+      engine_.fill(values_, BATCH);
+      next_ = 0;
+    }
+    return values_[next_++];
+  }
+
+ private:
+  static constexpr size_t BATCH = 256;
+
+  GalRandom& engine_;
+  double values_[BATCH];
+  size_t next_ = BATCH;
+};
+
+/**
+ * Generates the rows of the block: row v holds the accepted w < v in
+ * ascending order.
+ */
+void gnpBlock(RowBlock& block,
+              double probability,
+              size_t limit,
+              GalRandom& engine) {
+  block.rowEnds.assign(block.last - block.first, 0);
+  block.targets.clear();
+  if (probability <= 0.0 || limit == 0) {
+    return;
+  }
+
+  size_t v = block.first;
+  auto endRow = [&]() { block.rowEnds[v++ - block.first] = block.targets.size(); };
+
+  if (probability >= 1.0) {
+    while (v < block.last && block.targets.size() < limit) {
+      for (size_t w = 0; w < v && block.targets.size() < limit; ++w) {
+        block.targets.push_back(w);
+      }
+      endRow();
+    }
+  } else {
+    UniformBuffer uniform(engine);
+    const double logQ = std::log1p(-probability);
+    // no skip can be longer than all pairs of the block
+    const double maxSkip =
+        0.5 * block.last * static_cast<double>(block.last) + 1.0;
+    // the next candidate pair is (v, w)
+    size_t w = 0;
+    while (v < block.last) {
+      double skip = std::floor(std::log1p(-uniform()) / logQ);
+      if (skip >= maxSkip) {
+        break;
+      }
+      w += static_cast<size_t>(skip);
+      while (v < block.last && w >= v) {
+        w -= v;
+        endRow();
+      }
+      if (v == block.last) {
+        break;
+      }
+      block.targets.push_back(w++);
+      if (block.targets.size() == limit) {
+        break;
+      }
+    }
+  }
+  while (v < block.last) {
+    endRow();
+  }
+}
+
+/**
+ * Buffered writer of the text graph format.
+ */
+class TextGraphWriter {
+ public:
+  explicit TextGraphWriter(std::ostream& os) : os_(os) {}
+  ~TextGraphWriter() { flush(); }
+
+  void edge(size_t target) {
+    if (BUFFER_SIZE - used_ < MAX_NUMBER_LENGTH) {
+      flush();
+    }
+    if (!lineEmpty_) {
+      buffer_[used_++] = ' ';
+    }
+    used_ = std::to_chars(buffer_ + used_, buffer_ + BUFFER_SIZE, target).ptr -
+            buffer_;
+    lineEmpty_ = false;
+  }
+
+  void endLine() {
+    if (used_ == BUFFER_SIZE) {
+      flush();
+    }
+    buffer_[used_++] = '\n';
+    lineEmpty_ = true;
+  }
+
+  void flush() {
+    os_.write(buffer_, used_);
+    used_ = 0;
+  }
+
+ private:
+  static constexpr size_t BUFFER_SIZE = 1 << 16;
+  // a separator and the longest size_t
+  static constexpr size_t MAX_NUMBER_LENGTH = 21;
+
+  std::ostream& os_;
+  char buffer_[BUFFER_SIZE];
+  size_t used_ = 0;
+  bool lineEmpty_ = true;
+};
+
+/**
+ * Writes pairs of the lower triangle of the adjacency matrix given by their
+ * index in ascending order: pair (v, w), w < v, has index v * (v - 1) / 2 + w.
+ */
+class PairWriter {
+ public:
+  PairWriter(std::ostream& os, size_t nodeCount)
+      : writer_(os), nodeCount_(nodeCount) {}
+
+  void pair(uint64_t index) {
+    while (index >= rowStart_ + row_) {
+      rowStart_ += row_++;
+      writer_.endLine();
+    }
+    writer_.edge(index - rowStart_);
+  }
+
+  /**
+   * Terminates the remaining lines, so that every node has its line.
+   */
+  void finish() {
+    for (; row_ < nodeCount_; ++row_) {
+      writer_.endLine();
+    }
+    writer_.flush();
+  }
+
+ private:
+  TextGraphWriter writer_;
+  size_t nodeCount_;
+  size_t row_ = 0;
+  uint64_t rowStart_ = 0;
+};
+
+/**
+ * Uniform double in (0, 1>, so that its logarithm is finite.
+ */
+double openUniform(GalRandom& engine) {
+  return 1.0 - engine.uniformReal();
+}
+
+/**
+ * Selects count of the records <0, total) uniformly at random and calls
+ * select(index) for them in ascending order.
+ *
+ * Vitter's method D (An efficient algorithm for sequential random sampling,
+ * 1987) draws the gap to the next selected record directly, so it runs in
+ * O(count) expected time and constant memory. When few records remain
+ * compared to the selected ones, it switches to the simpler method A.
+ */
+template <typename F>
+void sampleSorted(uint64_t total,
+                  uint64_t count,
+                  GalRandom& engine,
+                  F&& select) {
+  if (count == 0) {
+    return;
+  }
+  // everything is signed, as in the original formulation
+  int64_t N = total;
+  int64_t n = count;
+  int64_t position = 0;
+  auto skipAndSelect = [&](int64_t skip) {
+    position += skip;
+    select(static_cast<uint64_t>(position++));
+  };
+
+  // method D
+  constexpr int64_t NEG_ALPHA_INV = -13;
+  double nreal = n;
+  double ninv = 1.0 / nreal;
+  double Nreal = N;
+  double vprime = std::exp(std::log(openUniform(engine)) * ninv);
+  int64_t qu1 = N - n + 1;
+  double qu1real = Nreal - nreal + 1.0;
+  int64_t threshold = -NEG_ALPHA_INV * n;
+  while (n > 1 && threshold < N) {
+    double nmin1inv = 1.0 / (nreal - 1.0);
+    int64_t S;
+    double negSreal;
+    while (true) {
+      double X;
+      // D2: generate X and the candidate skip S
+      while (true) {
+        X = Nreal * (1.0 - vprime);
+        S = static_cast<int64_t>(X);
+        if (S < qu1) {
+          break;
+        }
+        vprime = std::exp(std::log(openUniform(engine)) * ninv);
+      }
+      double U = openUniform(engine);
+      negSreal = -static_cast<double>(S);
+      // D3: fast acceptance test
+      double y1 = std::exp(std::log(U * Nreal / qu1real) * nmin1inv);
+      vprime = y1 * (1.0 - X / Nreal) * (qu1real / (negSreal + qu1real));
+      if (vprime <= 1.0) {
+        break;
+      }
+      // D4: exact acceptance test
+      double y2 = 1.0;
+      double top = Nreal - 1.0;
+      double bottom;
+      int64_t limit;
+      if (n - 1 > S) {
+        bottom = Nreal - nreal;
+        limit = N - S;
+      } else {
+        bottom = Nreal + negSreal - 1.0;
+        limit = qu1;
+      }
+      for (int64_t t = N - 1; t >= limit; --t) {
+        y2 = (y2 * top) / bottom;
+        top -= 1.0;
+        bottom -= 1.0;
+      }
+      if (Nreal / (Nreal - X) >= y1 * std::exp(std::log(y2) * nmin1inv)) {
+        vprime = std::exp(std::log(openUniform(engine)) * nmin1inv);
+        break;
+      }
+      vprime = std::exp(std::log(openUniform(engine)) * ninv);
+    }
+    skipAndSelect(S);
+    N = N - S - 1;
+    Nreal = Nreal + negSreal - 1.0;
+    --n;
+    nreal -= 1.0;
+    ninv = nmin1inv;
+    qu1 -= S;
+    qu1real += negSreal;
+    threshold += NEG_ALPHA_INV;
+  }
+
+  if (n == 1) {
+    skipAndSelect(static_cast<int64_t>(Nreal * vprime));
+    return;
+  }
+
+  // method A
+  double top = Nreal - n;
+  while (n >= 2) {
+    double V = engine.uniformReal();
+    int64_t S = 0;
+    double quot = top / Nreal;
+    while (quot > V) {
+      ++S;
+      top -= 1.0;
+      Nreal -= 1.0;
+      quot = (quot * top) / Nreal;
+    }
+    skipAndSelect(S);
+    Nreal -= 1.0;
+    --n;
+  }
+  skipAndSelect(
+      static_cast<int64_t>(std::round(Nreal) * engine.uniformReal()));
+}
+
+/**
+ * Distributes trials to categories with the given probabilities one category
+ * at a time: the count of each category is binomial with the trials left and
+ * its probability relative to the categories left. Exact, but needs no memory
+ * for the whole distribution.
+ */
+class SequentialMultinomial {
+ public:
+  SequentialMultinomial(uint64_t trials, double totalProbability)
+      : trials_(trials), probabilityLeft_(totalProbability) {}
+
+  uint64_t next(double probability, bool last, GalRandom& engine) {
+    if (trials_ == 0) {
+      return 0;
+    }
+    uint64_t count = trials_;
+    if (!last && probability < probabilityLeft_) {
+      count = engine.binomial(trials_,
+                              std::max(0.0, probability / probabilityLeft_));
+    }
+    trials_ -= count;
+    probabilityLeft_ -= probability;
+    return count;
+  }
+
+ private:
+  uint64_t trials_;
+  double probabilityLeft_;
+};
+
+/**
+ * Point of a random geometric graph.
+ */
+struct Point {
+  double x;
+  double y;
+  size_t id;
+};
+
+}  // namespace
+
+CsrArrays gnpEdges(size_t nodeCount,
+                   double probability,
+                   size_t limit,
+                   unsigned threads) {
+  // the blocks do not depend on the number of threads, so neither does the
+  // graph
+  constexpr size_t BLOCKS = 64;
+  const uint64_t seed = gal_thread_random()();
+  // row v has v pairs, so the blocks split the square of the row index evenly
+  std::vector<RowBlock> blocks(
+      std::max<size_t>(1, std::min<size_t>(BLOCKS, nodeCount)));
+  for (size_t i = 0; i < blocks.size(); ++i) {
+    double split = std::sqrt(static_cast<double>(i + 1) / blocks.size());
+    blocks[i].first = i == 0 ? 0 : blocks[i - 1].last;
+    blocks[i].last = i + 1 == blocks.size()
+                         ? nodeCount
+                         : std::max(blocks[i].first,
+                                    static_cast<size_t>(nodeCount * split));
+  }
+
+  parallelFor(blocks.size(), threads, [&](size_t i) {
+    GalRandom engine(seed, i);
+    gnpBlock(blocks[i], probability, limit, engine);
+  });
+
+  CsrArrays result;
+  result.offsets.reserve(nodeCount + 1);
+  result.offsets.push_back(0);
+  for (auto&& block : blocks) {
+    size_t base = result.adjacency.size();
+    for (auto end : block.rowEnds) {
+      result.offsets.push_back(std::min(limit, base + end));
+    }
+    size_t take = std::min(block.targets.size(), limit - std::min(limit, base));
+    result.adjacency.insert(result.adjacency.end(),
+                            block.targets.begin(),
+                            block.targets.begin() + take);
+  }
+  return result;
+}
+
+void writeGnm(std::ostream& os, size_t nodeCount, size_t edgeCount) {
+  const uint64_t pairs = static_cast<uint64_t>(nodeCount) *
+                         (nodeCount == 0 ? 0 : nodeCount - 1) / 2;
+  if (edgeCount > pairs) {
+    throw std::invalid_argument("Too many edges for the number of nodes.");
+  }
+  GalRandom engine(gal_thread_random()());
+  PairWriter writer(os, nodeCount);
+
+  if (edgeCount <= pairs / 2) {
+    sampleSorted(pairs, edgeCount, engine, [&](uint64_t index) {
+      writer.pair(index);
+    });
+  } else {
+    // dense graph, select the missing edges and write all the others
+    uint64_t next = 0;
+    sampleSorted(pairs, pairs - edgeCount, engine, [&](uint64_t missing) {
+      for (; next < missing; ++next) {
+        writer.pair(next);
+      }
+      next = missing + 1;
+    });
+    for (; next < pairs; ++next) {
+      writer.pair(next);
+    }
+  }
+  writer.finish();
+}
+
+void writeRmat(std::ostream& os,
+               size_t nodeCount,
+               size_t edgeCount,
+               double a,
+               double b,
+               double c) {
+  const double d = 1.0 - a - b - c;
+  if (a < 0.0 || b < 0.0 || c < 0.0 || d < 0.0 || a + b <= 0.0 ||
+      c + d <= 0.0) {
+    throw std::invalid_argument("Invalid R-MAT probabilities.");
+  }
+  if (nodeCount == 0 && edgeCount != 0) {
+    throw std::invalid_argument("Edges of a graph without nodes.");
+  }
+  GalRandom engine(gal_thread_random()());
+  TextGraphWriter writer(os);
+
+  unsigned scale = 0;
+  while ((size_t{1} << scale) < nodeCount) {
+    ++scale;
+  }
+  // the probability of row u is (a + b)^zeros * (c + d)^ones of its bits
+  auto rowProbability = [&](size_t u) {
+    unsigned ones = 0;
+    for (unsigned bit = 0; bit < scale; ++bit) {
+      ones += (u >> bit) & 1;
+    }
+    return std::pow(a + b, scale - ones) * std::pow(c + d, ones);
+  };
+  // the probability of a right column half given the row bit
+  auto rightProbability = [&](size_t u, unsigned bit) {
+    return (u >> bit) & 1 ? d / (c + d) : b / (a + b);
+  };
+  // below[k] is the probability that the lowest k column bits of row u are
+  // below those of nodeCount, below[scale] that the column is a node
+  std::vector<double> below(scale + 1);
+  auto columnsBelow = [&](size_t u) {
+    below[0] = nodeCount == size_t{1} << scale ? 1.0 : 0.0;
+    for (unsigned bit = 0; bit < scale; ++bit) {
+      double right = rightProbability(u, bit);
+      below[bit + 1] = (nodeCount >> bit) & 1
+                           ? (1.0 - right) + right * below[bit]
+                           : (1.0 - right) * below[bit];
+    }
+    return below[scale];
+  };
+  // rows above nodeCount are not generated at all, columns above it are
+  // cut off from the row
+  double total = 0.0;
+  size_t lastRow = 0;
+  for (size_t u = 0; u < nodeCount; ++u) {
+    double p = rowProbability(u) * columnsBelow(u);
+    total += p;
+    if (p > 0.0) {
+      lastRow = u;
+    }
+  }
+  if (edgeCount != 0 && !(total > 0.0)) {
+    throw std::invalid_argument(
+        "The R-MAT probabilities give no edge between the nodes.");
+  }
+
+  SequentialMultinomial rows(edgeCount, total);
+  for (size_t u = 0; u < nodeCount; ++u) {
+    const double valid = columnsBelow(u);
+    uint64_t count =
+        rows.next(rowProbability(u) * valid, u == lastRow, engine);
+    for (uint64_t e = 0; e < count; ++e) {
+      // the column bits from the top, given the row bits of each quadrant;
+      // while the column equals nodeCount so far, a bit is only set with
+      // the chance that the lower bits still stay below it
+      size_t column = 0;
+      bool bounded = nodeCount != size_t{1} << scale;
+      for (unsigned bit = scale; bit-- > 0;) {
+        double right = rightProbability(u, bit);
+        if (!bounded) {
+          column |= size_t{engine.uniformReal() < right} << bit;
+        } else if ((nodeCount >> bit) & 1) {
+          double whole = (1.0 - right) + right * below[bit];
+          if (engine.uniformReal() * whole < right * below[bit]) {
+            column |= size_t{1} << bit;
+          } else {
+            bounded = false;
+          }
+        }
+      }
+      writer.edge(column);
+    }
+    writer.endLine();
+  }
+  writer.flush();
+}
+
+void writeBarabasiAlbert(std::ostream& os,
+                         size_t nodeCount,
+                         size_t edgesPerNode) {
+  const uint64_t seed = gal_thread_random()();
+  // edge e connects node e / edgesPerNode to the node at position
+  // r(e) in <0, 2e> of the list of all edge ends, sources at even positions
+  // and targets at odd ones
+  auto target = [&](uint64_t e) {
+    uint64_t r = GalRandom(seed, e).uniform(2 * e + 1);
+    while (r % 2 == 1) {
+      e = r / 2;
+      r = GalRandom(seed, e).uniform(2 * e + 1);
+    }
+    return r / 2 / edgesPerNode;
+  };
+
+  TextGraphWriter writer(os);
+  for (size_t v = 0; v < nodeCount; ++v) {
+    for (size_t k = 0; k < edgesPerNode; ++k) {
+      writer.edge(target(static_cast<uint64_t>(v) * edgesPerNode + k));
+    }
+    writer.endLine();
+  }
+  writer.flush();
+}
+
+void writeGeometric(std::ostream& os, size_t nodeCount, double radius) {
+  if (!(radius > 0.0)) {
+    throw std::invalid_argument("The radius must be positive.");
+  }
+  GalRandom engine(gal_thread_random()());
+  TextGraphWriter writer(os);
+
+  // cells are at least as large as the radius, so neighbors are in adjacent
+  // cells only; there is no point in more cells than nodes
+  const size_t side = static_cast<size_t>(
+      std::clamp(std::floor(1.0 / radius),
+                 1.0,
+                 std::max(1.0, std::ceil(std::sqrt(nodeCount)))));
+  const double cellSize = 1.0 / side;
+  const double radius2 = radius * radius;
+  const double cellProbability = 1.0 / (static_cast<double>(side) * side);
+
+  SequentialMultinomial cells(nodeCount, 1.0);
+  std::vector<std::vector<Point>> previous(side);
+  std::vector<std::vector<Point>> current(side);
+  size_t nextId = 0;
+  auto connect = [&](const Point& point, const std::vector<Point>& cell) {
+    for (auto&& other : cell) {
+      double dx = point.x - other.x;
+      double dy = point.y - other.y;
+      if (other.id != point.id && dx * dx + dy * dy <= radius2) {
+        writer.edge(other.id);
+      }
+    }
+  };
+
+  for (size_t row = 0; row < side; ++row) {
+    std::swap(previous, current);
+    for (size_t column = 0; column < side; ++column) {
+      auto&& cell = current[column];
+      cell.clear();
+      uint64_t count = cells.next(
+          cellProbability, row + 1 == side && column + 1 == side, engine);
+      for (uint64_t i = 0; i < count; ++i) {
+        Point point{(column + engine.uniformReal()) * cellSize,
+                    (row + engine.uniformReal()) * cellSize,
+                    nextId++};
+        // all points of these cells are older than the new one
+        connect(point, cell);
+        if (column > 0) {
+          connect(point, current[column - 1]);
+        }
+        if (row > 0) {
+          for (size_t x = column == 0 ? 0 : column - 1;
+               x <= std::min(side - 1, column + 1);
+               ++x) {
+            connect(point, previous[x]);
+          }
+        }
+        writer.endLine();
+        cell.push_back(point);
+      }
+    }
+  }
+  writer.flush();
+}
+
+/*** End of file: generators.cpp ***/
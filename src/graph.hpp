@@ -3,46 +3,58 @@
  * @file graph.hpp
  * @date 30. 9. 2018
  * @author xvitra00, xdocek09
- * @brief Header file of module containing colored graph representation.
+ * @brief Header file of module containing graph and coloring representation.
  */
 #ifndef GAL_GRAPH_HPP
 #define GAL_GRAPH_HPP
 
 #include <algorithm>
+#include <iterator>
+#include <limits>
 #include <map>
+#include <memory>
+#include <ostream>
 #include <set>
 #include <sstream>
 #include <stdexcept>
 #include <string>
 #include <vector>
 
-#include <random.h>
+#include <generators.h>
+#include "graph_builder.hpp"
+#include "trace.h"
 
 /**
- * Unoriented, colored graph.
+ * Unoriented graph without colors.
+ *
+ * The graph is stored in the compressed sparse row format: the neighbors of
+ * node i are adjacency_[offsets_[i]] ... adjacency_[offsets_[i + 1] - 1],
+ * sorted in ascending order.
+ *
+ * The CSR arrays are immutable and shared between copies of the graph, so
+ * copies are cheap and any number of threads may read one graph at the same
+ * time. The arrays may be owned by the graph or live in another object, such
+ * as a memory mapped file. Colors are kept apart in a Coloring.
  */
-class ColoredGraph {
+class Graph {
  public:
-  class Node;
-
-  using iterator = std::vector<Node>::iterator;
-  using const_iterator = std::vector<Node>::const_iterator;
-
-  static constexpr size_t NO_COLOR = 0;
-  static constexpr size_t FIRST_COLOR = 1;
+  class Span;
+  using Edges = Span;
 
   /**
    * Creates graph from vector of vectors of edges.
    * @param[in] nodes	Vector that consists of vectors containing edges.
    * 	Each edge vector represents one node.
    */
-  ColoredGraph(std::vector<std::vector<size_t>>& nodes) {
-    for (size_t i = 0; i < nodes.size(); ++i) {
-      nodes_.push_back(Node(i, nodes[i], NO_COLOR));
+  Graph(std::vector<std::vector<size_t>>& nodes) {
+    std::vector<size_t> offsets(1, 0);
+    std::vector<size_t> adjacency;
+    offsets.reserve(nodes.size() + 1);
+    for (auto&& list : nodes) {
+      adjacency.insert(adjacency.end(), list.begin(), list.end());
+      offsets.push_back(adjacency.size());
     }
-    validateEdges();
-    minimizeEdges();
-    toUndirected();
+    build(offsets, adjacency, 1);
   }
 
   /**
@@ -59,290 +71,479 @@ class ColoredGraph {
    *
    * 		This example represents graph with three nodes (0-2) and 6 edges.
    */
-  ColoredGraph(std::istream& is) {
+  Graph(std::istream& is) {
+    std::vector<size_t> offsets(1, 0);
+    std::vector<size_t> adjacency;
     std::string line;
-    size_t id = 0;
 
     while (std::getline(is, line)) {
-      nodes_.push_back(Node(id, {}, 0));
-
       std::istringstream lineIss(line);
 
       size_t edge;
       while (lineIss >> edge)
-        nodes_.back().edges_.push_back(edge);
-
-      ++id;
+        adjacency.push_back(edge);
+      offsets.push_back(adjacency.size());
     }
 
-    validateEdges();
-    minimizeEdges();
-    toUndirected();
+    build(offsets, adjacency, 1);
   }
 
   /**
-   * Generate a random graph.
+   * Creates graph from raw CSR arrays, the same structure as the text
+   * format: edges of node i are adjacency[offsets[i]] ...
+   * adjacency[offsets[i + 1] - 1]. The edges may be directed, unsorted and
+   * contain duplicates or loops.
+   *
+   * @param[in] offsets	Offsets of the edge lists, size is nodeCount + 1.
+   * @param[in] adjacency	Concatenated edge lists.
+   * @param[in] threads	The number of threads used for the normalization.
+   * @throw invalid_argument	When node have transition to nonexistent node.
+   */
+  Graph(const std::vector<size_t>& offsets,
+        const std::vector<size_t>& adjacency,
+        unsigned threads = 1) {
+    build(offsets, adjacency, threads);
+  }
+
+  /**
+   * Creates graph from already normalized CSR arrays: the edge lists must be
+   * symmetric, sorted and without duplicates or loops. The arrays are used in
+   * place, the shared pointers keep their owner alive.
+   *
+   * @param[in] offsets	Offsets of the edge lists, nodeCount + 1 values.
+   * @param[in] adjacency	Concatenated edge lists, edgeCount values.
+   * @param[in] nodeCount	The number of nodes.
+   * @param[in] edgeCount	The number of stored (directed) edges.
+   */
+  Graph(std::shared_ptr<const size_t> offsets,
+        std::shared_ptr<const size_t> adjacency,
+        size_t nodeCount,
+        size_t edgeCount)
+      : offsets_(std::move(offsets))
+      , adjacency_(std::move(adjacency))
+      , nodeCount_(nodeCount)
+      , edgeCount_(edgeCount) {}
+
+  /**
+   * Generate a random graph in time proportional to its size, see gnpEdges().
    *
    * @param size The number of nodes.
    * @param edgePropability The propability of an edge between two nodes.
    * @param limit The optional upper limit for the number of edges.
+   * @param threads The number of threads, 0 means all hardware threads.
    */
-  ColoredGraph(size_t size,
-               double edgePropability,
-               size_t limit = std::numeric_limits<size_t>::max()) {
-    for (size_t i = 0; i < size; ++i) {
-      nodes_.push_back(Node(i, {}, NO_COLOR));
-    }
-    // leads to undirected, unique, sorted edges
-    for (size_t i = 0; i < size; ++i) {
-      for (size_t j = i + 1; j < size; ++j) {
-        if (gal_rand(1.0) < edgePropability && limit != 0) {
-          nodes_[i].edges_.push_back(j);
-          nodes_[j].edges_.push_back(i);
-          --limit;
-        }
-      }
-    }
+  Graph(size_t size,
+        double edgePropability,
+        size_t limit = std::numeric_limits<size_t>::max(),
+        unsigned threads = 1) {
+    CsrArrays edges = gnpEdges(size, edgePropability, limit, threads);
+    build(edges.offsets, edges.adjacency, threads);
   }
 
-  ColoredGraph(const ColoredGraph&) = default;
-  ColoredGraph(ColoredGraph&&) noexcept = default;
-  ColoredGraph& operator=(const ColoredGraph&) = default;
-  ColoredGraph& operator=(ColoredGraph&&) noexcept = default;
+  Graph(const Graph&) = default;
+  Graph(Graph&&) noexcept = default;
+  Graph& operator=(const Graph&) = default;
+  Graph& operator=(Graph&&) noexcept = default;
 
   /**
    * Create a random graph.
    * @param size The number of nodes.
    * @param edgePropability The propability of an edge between two nodes.
    * @param limit The optional upper limit for the number of edges.
+   * @param threads The number of threads, 0 means all hardware threads.
    */
-  static ColoredGraph randomGraph(
-      size_t size,
-      double edgePropability,
-      size_t limit = std::numeric_limits<size_t>::max()) {
-    return std::move(ColoredGraph(size, edgePropability, limit));
+  static Graph randomGraph(size_t size,
+                           double edgePropability,
+                           size_t limit = std::numeric_limits<size_t>::max(),
+                           unsigned threads = 1) {
+    return Graph(size, edgePropability, limit, threads);
   }
 
-  size_t size() { return nodes_.size(); }
-  size_t edgeCount() {
-    size_t s = 0;
-    for (auto&& node : nodes_) {
-      s += node.edges().size();
-    }
-    return s;
-  }
+  size_t size() const noexcept { return nodeCount_; }
+  /**
+   * The number of stored (directed) edges, every undirected edge is counted
+   * twice.
+   */
+  size_t edgeCount() const noexcept { return edgeCount_; }
 
-  iterator begin() { return nodes_.begin(); }
-  iterator end() { return nodes_.end(); }
+  /**
+   * Get the sorted neighbors of the Nth node.
+   */
+  Edges neighbors(size_t i) const noexcept;
 
-  const_iterator begin() const { return nodes_.cbegin(); }
-  const_iterator end() const { return nodes_.cend(); }
+  size_t degree(size_t i) const noexcept {
+    return offsets_.get()[i + 1] - offsets_.get()[i];
+  }
 
   /**
-   * Get the Nth node.
+   * Returns true if there is an edge between nodes a and b.
    */
-  Node& operator[](size_t i) noexcept { return nodes_[i]; }
-  Node& node(size_t i) noexcept { return nodes_[i]; }
+  bool edgeTo(size_t a, size_t b) const noexcept {
+    auto&& edges = neighbors(a);
+    auto it = std::lower_bound(edges.begin(), edges.end(), b);
+    return it != edges.end() && *it == b;
+  }
 
-  const Node& operator[](size_t i) const noexcept { return nodes_[i]; }
-  const Node& node(size_t i) const noexcept { return nodes_[i]; }
+  /**
+   * Raw CSR arrays. offsets() has size() + 1 elements.
+   */
+  Span offsets() const noexcept;
+  Span adjacency() const noexcept;
 
+  /**
+   * Inserts an undirected edge between a and b.
+   * The shared CSR arrays are not modified, this graph gets new ones, so this
+   * is O(n + m); build the graph from edge lists instead when inserting many
+   * edges.
+   *
+   * @return False if the edge could not be inserted or already exists.
+   */
   bool insertEdge(size_t a, size_t b) {
     if (a == b || a >= size() || b >= size()) {
       return false;
     }
-    auto&& n1 = node(a);
-    auto&& n2 = node(b);
-    if (n1.edgeTo(b)) {
+    if (edgeTo(a, b)) {
       return false;
     }
-    auto it = std::lower_bound(n1.edges_.begin(), n1.edges_.end(), b);
-    n1.edges_.insert(it, b);
-    it = std::lower_bound(n2.edges_.begin(), n2.edges_.end(), a);
-    n2.edges_.insert(it, a);
+    std::vector<size_t> offsets(offsets_.get(), offsets_.get() + size() + 1);
+    std::vector<size_t> adjacency(adjacency_.get(),
+                                  adjacency_.get() + edgeCount_);
+    // insert into the list with the higher offset first, so the position
+    // of the other one stays valid
+    if (a < b) {
+      std::swap(a, b);
+    }
+    auto insertSorted = [&](size_t from, size_t to) {
+      auto first = adjacency.begin() + offsets[from];
+      auto last = adjacency.begin() + offsets[from + 1];
+      adjacency.insert(std::lower_bound(first, last, to), to);
+      for (size_t i = from + 1; i < offsets.size(); ++i) {
+        ++offsets[i];
+      }
+    };
+    insertSorted(a, b);
+    insertSorted(b, a);
 
+    edgeCount_ = adjacency.size();
+    offsets_ = share(std::move(offsets));
+    adjacency_ = share(std::move(adjacency));
     return true;
   }
 
-  /**
-   * Prints graph to ostream.
-   *
-   * @param[in] os Stream the graph will be printed to.
-   * @param[in] g Graph for printing.
-   * @return the stream
-   */
-  friend std::ostream& operator<<(std::ostream& os, const ColoredGraph& g) {
-    for (const auto& node : g.nodes_) {
-      os << node.id() << ") color: " << node.color() << ", edges: ";
-      auto&& edges = node.edges();
-      auto it = edges.begin();
-
-      if (it != edges.end()) {
-        os << *it++;
-      }
-      while (it != edges.end()) {
-        os << " " << *it++;
-      }
-      os << "\n";
-    }
-    return os;
-  }
   /**
    * Prints graph to ostream in the same format it's read in the constructor.
-   * (So without colors.)
    *
    * @param[out] os Stream the graph will be printed to.
    */
-  void print(std::ostream& os) {
-    for (const auto& node : nodes_) {
-      auto&& edges = node.edges();
-      auto it = edges.begin();
-
-      if (it != edges.end()) {
-        os << *it++;
-      }
-      while (it != edges.end()) {
-        os << " " << *it++;
-      }
+  void print(std::ostream& os) const {
+    for (size_t i = 0; i < size(); ++i) {
+      printEdges(os, i);
       os << "\n";
     }
   }
 
-  class Node {
+  /**
+   * Read-only contiguous range of values, such as the neighbors of one node.
+   */
+  class Span {
    public:
-    friend class ColoredGraph;
-    Node(size_t id, const std::vector<size_t>& edges, size_t color) noexcept
-        : id_(id), edges_(edges), color_(color) {}
+    using value_type = size_t;
+    using const_iterator = const size_t*;
+    using iterator = const_iterator;
 
-    size_t id() const noexcept { return id_; }
-    explicit operator size_t() const noexcept { return id(); }
+    Span(const size_t* first, const size_t* last) noexcept
+        : begin_(first), end_(last) {}
 
-    const std::vector<size_t>& edges() const noexcept { return edges_; }
+    const size_t* begin() const noexcept { return begin_; }
+    const size_t* end() const noexcept { return end_; }
+    size_t size() const noexcept { return end_ - begin_; }
+    bool empty() const noexcept { return begin_ == end_; }
+    size_t operator[](size_t i) const noexcept { return begin_[i]; }
 
-    /**
-     * Returns true if this node has a transition to a different node.
-     */
-    bool edgeTo(size_t i) noexcept {
-      auto it = std::lower_bound(edges_.begin(), edges_.end(), i);
-      return it != edges_.end() && *it == i;
+   private:
+    const size_t* begin_;
+    const size_t* end_;
+  };
+
+ protected:
+  void printEdges(std::ostream& os, size_t i) const {
+    auto&& edges = neighbors(i);
+    auto it = edges.begin();
+
+    if (it != edges.end()) {
+      os << *it++;
+    }
+    while (it != edges.end()) {
+      os << " " << *it++;
     }
+  }
 
-    size_t color() const noexcept { return color_; }
-    size_t& color() noexcept { return color_; }
+ private:
+  std::shared_ptr<const size_t> offsets_;
+  std::shared_ptr<const size_t> adjacency_;
+  size_t nodeCount_ = 0;
+  size_t edgeCount_ = 0;
 
-   private:
-    size_t id_;
-    std::vector<size_t> edges_;
-    size_t color_;
-  };
+  /**
+   * Moves the vector to shared storage and points to its data.
+   */
+  static std::shared_ptr<const size_t> share(std::vector<size_t>&& values) {
+    auto owner = std::make_shared<const std::vector<size_t>>(std::move(values));
+    return {owner, owner->data()};
+  }
 
   /**
-   * Clears colors from all nodes.
+   * Normalizes raw CSR arrays and takes the result as the graph structure.
    */
-  void clearColors() {
-    for (auto& n : *this)
-      n.color_ = NO_COLOR;
-    colorCount_ = 0;
+  void build(const std::vector<size_t>& offsets,
+             const std::vector<size_t>& adjacency,
+             unsigned threads) {
+    if (offsets.empty() || offsets.back() != adjacency.size()) {
+      throw std::invalid_argument("Edge offsets do not match the edges.");
+    }
+    nodeCount_ = offsets.size() - 1;
+    CsrArrays csr =
+        buildUndirected(offsets.data(), adjacency.data(), nodeCount_, threads);
+    edgeCount_ = csr.adjacency.size();
+    offsets_ = share(std::move(csr.offsets));
+    adjacency_ = share(std::move(csr.adjacency));
   }
+};
+
+/**
+ * Colors of the nodes of one graph and the number of colors used, the result
+ * of a coloring algorithm. Colors start at FIRST_COLOR, NO_COLOR marks an
+ * uncolored node.
+ *
+ * The algorithms fill a coloring of a const Graph, so several colorings of
+ * one graph can be computed at the same time.
+ */
+class Coloring {
+ public:
+  static constexpr size_t NO_COLOR = 0;
+  static constexpr size_t FIRST_COLOR = 1;
+
+  Coloring() = default;
+
+  /**
+   * Creates a coloring of size uncolored nodes.
+   */
+  explicit Coloring(size_t size) : colors_(size, NO_COLOR) {}
+
+  size_t size() const noexcept { return colors_.size(); }
+
+  size_t& color(size_t i) noexcept { return colors_[i]; }
+  const size_t& color(size_t i) const noexcept { return colors_[i]; }
+
+  const std::vector<size_t>& colors() const noexcept { return colors_; }
 
   size_t& colorCount() noexcept { return colorCount_; }
   const size_t& colorCount() const noexcept { return colorCount_; }
 
+  /**
+   * Clears colors from all nodes.
+   */
+  void clear() {
+    std::fill(colors_.begin(), colors_.end(), NO_COLOR);
+    colorCount_ = 0;
+  }
+
   /**
    * Checks if graph is colored.
    * 	All nodes have colors and no two connected nodes have same color.
    *
    * @return True -> colored. False -> something fishy.
    */
-  bool validateColors() const {
-    for (const auto& node : nodes_) {
-      if (node.color() == NO_COLOR)
+  bool validate(const Graph& graph) const {
+    GAL_TRACE_SPAN("validate colors");
+    if (size() != graph.size())
+      return false;
+    for (size_t i = 0; i < size(); ++i) {
+      if (colors_[i] == NO_COLOR)
         return false;
-      for (const auto& edge : node.edges())
-        if (nodes_[edge].color() == node.color())
+      for (auto neighbor : graph.neighbors(i))
+        if (colors_[neighbor] == colors_[i])
           return false;
     }
     return true;
   }
 
  private:
-  std::vector<Node> nodes_;
+  std::vector<size_t> colors_;
   size_t colorCount_ = 0;
+};
+
+/**
+ * A graph together with one coloring of it, for printing and for node views
+ * with colors. The coloring algorithms take the two apart.
+ */
+class ColoredGraph : public Graph {
+ public:
+  template <typename G>
+  class BasicNode;
+  template <typename G>
+  class NodeIterator;
+
+  using Node = BasicNode<ColoredGraph>;
+  using ConstNode = BasicNode<const ColoredGraph>;
+  using iterator = NodeIterator<ColoredGraph>;
+  using const_iterator = NodeIterator<const ColoredGraph>;
+
+  static constexpr size_t NO_COLOR = Coloring::NO_COLOR;
+  static constexpr size_t FIRST_COLOR = Coloring::FIRST_COLOR;
 
   /**
-   * Performs graph validation.
+   * Takes the graph with all nodes uncolored.
+   */
+  ColoredGraph(Graph graph)
+      : Graph(std::move(graph)), coloring_(Graph::size()) {}
+
+  /**
+   * Takes the graph with a coloring of it.
    *
-   * @throw invalid_argument	When node have transition to nonexistent node.
+   * @throw invalid_argument	When the coloring has another number of nodes.
    */
-  void validateEdges() {
-    for (auto&& node : nodes_) {
-      // validate edges
-      for (auto&& nextNode : node.edges_) {
-        if (nextNode >= size()) {
-          throw std::invalid_argument("Node transition to nonexistent node.");
-        }
-      }
+  ColoredGraph(Graph graph, Coloring coloring)
+      : Graph(std::move(graph)), coloring_(std::move(coloring)) {
+    if (coloring_.size() != size()) {
+      throw std::invalid_argument("Coloring does not match the graph.");
     }
   }
+
+  const Graph& graph() const noexcept { return *this; }
+  Coloring& coloring() noexcept { return coloring_; }
+  const Coloring& coloring() const noexcept { return coloring_; }
+
+  iterator begin() noexcept { return {*this, 0}; }
+  iterator end() noexcept { return {*this, size()}; }
+
+  const_iterator begin() const noexcept { return {*this, 0}; }
+  const_iterator end() const noexcept { return {*this, size()}; }
+
   /**
-   * Transforms the transition lists of all nodes to unique sorted lists.
+   * Get the Nth node.
    */
-  void minimizeEdges() {
-    for (auto&& node : nodes_) {
-      auto&& transitionList = node.edges_;
-      // sort and limit edges to at most 1
-      std::sort(transitionList.begin(), transitionList.end());
-      transitionList.erase(
-          std::unique(transitionList.begin(), transitionList.end()),
-          transitionList.end());
-    }
+  Node operator[](size_t i) noexcept { return {*this, i}; }
+  Node node(size_t i) noexcept { return {*this, i}; }
+
+  ConstNode operator[](size_t i) const noexcept { return {*this, i}; }
+  ConstNode node(size_t i) const noexcept { return {*this, i}; }
+
+  size_t& color(size_t i) noexcept { return coloring_.color(i); }
+  const size_t& color(size_t i) const noexcept { return coloring_.color(i); }
+
+  const std::vector<size_t>& colors() const noexcept {
+    return coloring_.colors();
   }
 
+  size_t& colorCount() noexcept { return coloring_.colorCount(); }
+  const size_t& colorCount() const noexcept { return coloring_.colorCount(); }
+
+  /**
+   * Clears colors from all nodes.
+   */
+  void clearColors() { coloring_.clear(); }
+
   /**
-   * Converts the directed graph to an undirected one.
+   * Checks if graph is colored, see Coloring::validate().
    */
-  void toUndirected() {
-    edgeSymmetrization();
-    // remove the loops and edges that are there multiple times
-    std::vector<size_t> connectedWith(nodes_.size(), nodes_.size());
-    for (auto& node : nodes_) {
-      std::vector<size_t> newEdges;
-      for (auto edge : node.edges()) {
-        if (connectedWith[edge] != node.id() && edge != node.id()) {
-          newEdges.push_back(edge);
-          connectedWith[edge] = node.id();
-        }
-      }
-      node.edges_.swap(newEdges);
+  bool validateColors() const { return coloring_.validate(*this); }
+
+  /**
+   * Prints graph to ostream.
+   *
+   * @param[in] os Stream the graph will be printed to.
+   * @param[in] g Graph for printing.
+   * @return the stream
+   */
+  friend std::ostream& operator<<(std::ostream& os, const ColoredGraph& g) {
+    for (size_t i = 0; i < g.size(); ++i) {
+      os << i << ") color: " << g.color(i) << ", edges: ";
+      g.printEdges(os, i);
+      os << "\n";
     }
+    return os;
   }
 
   /**
-   * Performs the symmetrization of edges.
+   * Lightweight view of one node. G is either ColoredGraph or
+   * const ColoredGraph, which determines whether the color can be modified.
    */
-  void edgeSymmetrization() {
-    for (auto& node : nodes_) {
-      // num of edges on the start
-      size_t numOfEdges = node.edges_.size();
-      for (size_t i = 0; i < numOfEdges; ++i) {
-        if (node.edges_[i] < nodes_.size()) {
-          // original edge
-          if (node.id() < node.edges_[i]) {
-            // needs marking because of future processing
-            nodes_[node.edges_[i]].edges_.push_back(nodes_.size() + node.id());
-          } else {
-            // no need for, mark because the node was already processed
-            nodes_[node.edges_[i]].edges_.push_back(node.id());
-          }
-        } else {
-          // this edge was symmetrized
-          // lets remove the mark
-          node.edges_[i] -= nodes_.size();
-        }
-      }
+  template <typename G>
+  class BasicNode {
+   public:
+    BasicNode(G& graph, size_t id) noexcept : graph_(&graph), id_(id) {}
+
+    size_t id() const noexcept { return id_; }
+    explicit operator size_t() const noexcept { return id(); }
+
+    Edges edges() const noexcept { return graph_->neighbors(id_); }
+
+    /**
+     * Returns true if this node has a transition to a different node.
+     */
+    bool edgeTo(size_t i) const noexcept { return graph_->edgeTo(id_, i); }
+
+    decltype(auto) color() const noexcept { return graph_->color(id_); }
+
+   private:
+    G* graph_;
+    size_t id_;
+  };
+
+  template <typename G>
+  class NodeIterator {
+   public:
+    using iterator_category = std::input_iterator_tag;
+    using value_type = BasicNode<G>;
+    using difference_type = std::ptrdiff_t;
+    using pointer = void;
+    using reference = BasicNode<G>;
+
+    NodeIterator(G& graph, size_t id) noexcept : graph_(&graph), id_(id) {}
+
+    reference operator*() const noexcept { return {*graph_, id_}; }
+    NodeIterator& operator++() noexcept {
+      ++id_;
+      return *this;
     }
-  }
+    NodeIterator operator++(int) noexcept {
+      NodeIterator tmp = *this;
+      ++id_;
+      return tmp;
+    }
+    difference_type operator-(const NodeIterator& other) const noexcept {
+      return id_ - other.id_;
+    }
+    bool operator==(const NodeIterator& other) const noexcept {
+      return id_ == other.id_;
+    }
+    bool operator!=(const NodeIterator& other) const noexcept {
+      return id_ != other.id_;
+    }
+
+   private:
+    G* graph_;
+    size_t id_;
+  };
+
+ private:
+  Coloring coloring_;
 };
 
+inline Graph::Edges Graph::neighbors(size_t i) const noexcept {
+  const size_t* offsets = offsets_.get();
+  const size_t* data = adjacency_.get();
+  return {data + offsets[i], data + offsets[i + 1]};
+}
+
+inline Graph::Span Graph::offsets() const noexcept {
+  return {offsets_.get(), offsets_.get() + size() + 1};
+}
+
+inline Graph::Span Graph::adjacency() const noexcept {
+  return {adjacency_.get(), adjacency_.get() + edgeCount_};
+}
+
 #endif
 /*** End of file: graph.hpp ***/
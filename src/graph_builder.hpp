@@ -0,0 +1,264 @@
+/**
+ * Project: gal
+ * @file graph_builder.hpp
+ * @date 17. 10. 2026
+ * @author xvitra00, xdocek09
+ * @brief Normalization of raw edge lists to undirected CSR arrays.
+ */
+#ifndef GAL_GRAPH_BUILDER_HPP
+#define GAL_GRAPH_BUILDER_HPP
+
+#include <algorithm>
+#include <atomic>
+#include <stdexcept>
+#include <vector>
+
+#include "parallel.hpp"
+
+/**
+ * CSR arrays: the edges of node i are adjacency[offsets[i]] ...
+ * adjacency[offsets[i + 1] - 1].
+ */
+struct CsrArrays {
+  std::vector<size_t> offsets;
+  std::vector<size_t> adjacency;
+};
+
+namespace detail {
+
+/**
+ * Turns counts stored at index i + 1 to starting offsets.
+ */
+inline void prefixSum(std::vector<size_t>& values) {
+  for (size_t i = 1; i < values.size(); ++i) {
+    values[i] += values[i - 1];
+  }
+}
+
+inline void checkEdge(size_t target, size_t nodeCount) {
+  if (target >= nodeCount) {
+    throw std::invalid_argument("Node transition to nonexistent node.");
+  }
+}
+
+/**
+ * Single threaded builder, two counting sort passes.
+ *
+ * The first pass puts every edge to the buckets of both of its nodes, so the
+ * bucket of x holds all neighbors of x in no particular order. The second
+ * pass goes through the buckets in the order of their nodes y and appends y
+ * to the list of every x in the bucket, which leaves each list sorted and
+ * lets duplicates be dropped by comparing with the last appended node.
+ */
+inline CsrArrays buildUndirectedSequential(const size_t* offsets,
+                                           const size_t* adjacency,
+                                           size_t nodeCount) {
+  std::vector<size_t> start(nodeCount + 1, 0);
+  for (size_t u = 0; u < nodeCount; ++u) {
+    for (size_t e = offsets[u]; e < offsets[u + 1]; ++e) {
+      size_t v = adjacency[e];
+      checkEdge(v, nodeCount);
+      if (u != v) {
+        ++start[u + 1];
+        ++start[v + 1];
+      }
+    }
+  }
+  prefixSum(start);
+
+  std::vector<size_t> buckets(start[nodeCount]);
+  std::vector<size_t> cursor(start.begin(), start.end() - 1);
+  for (size_t u = 0; u < nodeCount; ++u) {
+    for (size_t e = offsets[u]; e < offsets[u + 1]; ++e) {
+      size_t v = adjacency[e];
+      if (u != v) {
+        buckets[cursor[v]++] = u;
+        buckets[cursor[u]++] = v;
+      }
+    }
+  }
+
+  CsrArrays result;
+  result.offsets.assign(nodeCount + 1, 0);
+  // the last node appended to each list, nodeCount for none
+  std::vector<size_t>& last = cursor;
+  std::fill(last.begin(), last.end(), nodeCount);
+  for (size_t y = 0; y < nodeCount; ++y) {
+    for (size_t i = start[y]; i < start[y + 1]; ++i) {
+      size_t x = buckets[i];
+      if (last[x] != y) {
+        ++result.offsets[x + 1];
+        last[x] = y;
+      }
+    }
+  }
+  prefixSum(result.offsets);
+
+  result.adjacency.resize(result.offsets[nodeCount]);
+  std::vector<size_t> position(result.offsets.begin(),
+                               result.offsets.end() - 1);
+  std::fill(last.begin(), last.end(), nodeCount);
+  for (size_t y = 0; y < nodeCount; ++y) {
+    for (size_t i = start[y]; i < start[y + 1]; ++i) {
+      size_t x = buckets[i];
+      if (last[x] != y) {
+        result.adjacency[position[x]++] = y;
+        last[x] = y;
+      }
+    }
+  }
+  return result;
+}
+
+/**
+ * Multithreaded builder, the counting sort passes of the single threaded one
+ * split among threads.
+ *
+ * Edges are counted and scattered to the buckets of both nodes with atomic
+ * counters, so the order within a bucket is arbitrary. The buckets are then
+ * transposed: the nodes y are split into contiguous chunks and each chunk
+ * appends its y, in increasing order, to the lists of the nodes x in the
+ * bucket of y. Counting the entries of every chunk for every x first gives
+ * each chunk its own place in each list, after the places of the chunks of
+ * smaller y, so every list comes out sorted. Duplicates are then adjacent and
+ * dropped when the lists are compacted. The counters of the chunks take
+ * chunks * n values, so there are at most as many chunks as the buckets have
+ * entries per node, which keeps the builder in O(n + m) time and memory.
+ */
+inline CsrArrays buildUndirectedParallel(const size_t* offsets,
+                                         const size_t* adjacency,
+                                         size_t nodeCount,
+                                         unsigned threads) {
+  // nodes handed to one thread at a time in the per node passes
+  constexpr size_t NODE_BLOCK = 1024;
+  const size_t blocks = (nodeCount + NODE_BLOCK - 1) / NODE_BLOCK;
+  auto forNodeBlocks = [&](auto&& f) {
+    parallelFor(blocks, threads, [&](size_t block) {
+      size_t end = std::min(nodeCount, (block + 1) * NODE_BLOCK);
+      for (size_t u = block * NODE_BLOCK; u < end; ++u) {
+        f(u);
+      }
+    });
+  };
+
+  std::vector<std::atomic<size_t>> counter(nodeCount);
+  forNodeBlocks([&](size_t u) {
+    for (size_t e = offsets[u]; e < offsets[u + 1]; ++e) {
+      size_t v = adjacency[e];
+      checkEdge(v, nodeCount);
+      if (u != v) {
+        counter[u].fetch_add(1, std::memory_order_relaxed);
+        counter[v].fetch_add(1, std::memory_order_relaxed);
+      }
+    }
+  });
+  std::vector<size_t> start(nodeCount + 1, 0);
+  for (size_t u = 0; u < nodeCount; ++u) {
+    start[u + 1] = start[u] + counter[u].load(std::memory_order_relaxed);
+    counter[u].store(start[u], std::memory_order_relaxed);
+  }
+
+  std::vector<size_t> buckets(start[nodeCount]);
+  forNodeBlocks([&](size_t u) {
+    for (size_t e = offsets[u]; e < offsets[u + 1]; ++e) {
+      size_t v = adjacency[e];
+      if (u != v) {
+        buckets[counter[v].fetch_add(1, std::memory_order_relaxed)] = u;
+        buckets[counter[u].fetch_add(1, std::memory_order_relaxed)] = v;
+      }
+    }
+  });
+  counter = std::vector<std::atomic<size_t>>();
+
+  // chunks of about the same number of bucket entries
+  const size_t entries = start[nodeCount];
+  const size_t chunks = std::max<size_t>(
+      1, std::min<size_t>(threads, entries / std::max<size_t>(1, nodeCount)));
+  std::vector<size_t> chunkStart(chunks + 1, nodeCount);
+  for (size_t c = 0; c < chunks; ++c) {
+    chunkStart[c] =
+        std::lower_bound(start.begin(), start.end(), entries * c / chunks) -
+        start.begin();
+  }
+  // place[c][x]: the count, then the next place of chunk c in the list of x
+  std::vector<std::vector<size_t>> place(chunks);
+  parallelFor(chunks, threads, [&](size_t c) {
+    place[c].assign(nodeCount, 0);
+    for (size_t y = chunkStart[c]; y < chunkStart[c + 1]; ++y) {
+      for (size_t i = start[y]; i < start[y + 1]; ++i) {
+        ++place[c][buckets[i]];
+      }
+    }
+  });
+  // the bucket of x has as many entries as there are x in all the buckets
+  forNodeBlocks([&](size_t x) {
+    size_t next = start[x];
+    for (size_t c = 0; c < chunks; ++c) {
+      size_t count = place[c][x];
+      place[c][x] = next;
+      next += count;
+    }
+  });
+  std::vector<size_t> sorted(entries);
+  parallelFor(chunks, threads, [&](size_t c) {
+    for (size_t y = chunkStart[c]; y < chunkStart[c + 1]; ++y) {
+      for (size_t i = start[y]; i < start[y + 1]; ++i) {
+        sorted[place[c][buckets[i]]++] = y;
+      }
+    }
+  });
+  place = std::vector<std::vector<size_t>>();
+  buckets = std::vector<size_t>();
+
+  CsrArrays result;
+  result.offsets.assign(nodeCount + 1, 0);
+  forNodeBlocks([&](size_t x) {
+    auto first = sorted.begin() + start[x];
+    auto last = sorted.begin() + start[x + 1];
+    size_t unique = 0;
+    for (auto it = first; it != last; ++it) {
+      unique += it == first || *it != *(it - 1);
+    }
+    result.offsets[x + 1] = unique;
+  });
+  prefixSum(result.offsets);
+
+  result.adjacency.resize(result.offsets[nodeCount]);
+  forNodeBlocks([&](size_t x) {
+    std::unique_copy(sorted.begin() + start[x],
+                     sorted.begin() + start[x + 1],
+                     result.adjacency.begin() + result.offsets[x]);
+  });
+  return result;
+}
+
+}  // namespace detail
+
+/**
+ * Builds undirected CSR arrays from raw ones: edges are symmetrized, each
+ * list is sorted and duplicates and loops are removed. Both the single
+ * threaded and the multithreaded builder run in O(n + m) without sorting.
+ *
+ * @param[in] offsets	Offsets of the raw edge lists, nodeCount + 1 values.
+ * @param[in] adjacency	Concatenated raw edge lists.
+ * @param[in] nodeCount	The number of nodes.
+ * @param[in] threads	The number of threads, 0 means all hardware threads.
+ * @throw invalid_argument	When node have transition to nonexistent node.
+ */
+inline CsrArrays buildUndirected(const size_t* offsets,
+                                 const size_t* adjacency,
+                                 size_t nodeCount,
+                                 unsigned threads = 1) {
+  GAL_TRACE_SPAN("normalize edges");
+  if (threads == 0) {
+    threads = defaultThreadCount();
+  }
+  if (threads == 1) {
+    return detail::buildUndirectedSequential(offsets, adjacency, nodeCount);
+  }
+  return detail::buildUndirectedParallel(
+      offsets, adjacency, nodeCount, threads);
+}
+
+#endif
+/*** End of file: graph_builder.hpp ***/
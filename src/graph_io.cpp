@@ -0,0 +1,410 @@
+/**
+ * Project: gal
+ * @file graph_io.cpp
+ * @date 17. 10. 2026
+ * @author xvitra00, xdocek09
+ * @brief Source file of module for loading graphs from files.
+ */
+
+#include "graph_io.h"
+
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#include <algorithm>
+#include <atomic>
+#include <charconv>
+#include <cstring>
+#include <fstream>
+#include <memory>
+#include <numeric>
+#include <stdexcept>
+#include <utility>
+#include <vector>
+
+#include "parallel.hpp"
+
+MappedFile::MappedFile(const std::string& filename) {
+  int fd = ::open(filename.c_str(), O_RDONLY);
+  if (fd < 0) {
+    throw std::runtime_error("Can not open " + filename + " for reading.");
+  }
+  struct stat info;
+  if (::fstat(fd, &info) != 0) {
+    ::close(fd);
+    throw std::runtime_error("Can not read " + filename + ".");
+  }
+  size_ = info.st_size;
+  if (size_ != 0) {
+    void* mapping = ::mmap(nullptr, size_, PROT_READ, MAP_PRIVATE, fd, 0);
+    if (mapping == MAP_FAILED) {
+      ::close(fd);
+      throw std::runtime_error("Can not map " + filename + " to memory.");
+    }
+    ::madvise(mapping, size_, MADV_WILLNEED);
+    data_ = static_cast<const char*>(mapping);
+  }
+  ::close(fd);
+}
+
+MappedFile::~MappedFile() {
+  if (data_ != nullptr) {
+    ::munmap(const_cast<char*>(data_), size_);
+  }
+}
+
+namespace {
+
+// chunks smaller than this are not worth a separate task
+constexpr size_t MIN_CHUNK_SIZE = 1 << 20;
+
+inline bool isDigit(char c) noexcept { return c >= '0' && c <= '9'; }
+
+inline bool isBlank(char c) noexcept {
+  return c == ' ' || c == '\t' || c == '\r' || c == '\v' || c == '\f';
+}
+
+/**
+ * Part of the file with whole lines only.
+ */
+struct Chunk {
+  const char* begin;
+  const char* end;
+  size_t lines = 0;
+  size_t edges = 0;
+  // the first node and the first edge index of this chunk in the whole graph
+  size_t firstNode = 0;
+  size_t firstEdge = 0;
+};
+
+std::vector<Chunk> splitToChunks(const char* data,
+                                 size_t size,
+                                 unsigned threads) {
+  size_t count = std::max<size_t>(
+      1, std::min<size_t>(threads * 4, size / MIN_CHUNK_SIZE));
+  std::vector<Chunk> chunks;
+  const char* end = data + size;
+  const char* begin = data;
+  for (size_t i = 1; i <= count && begin != end; ++i) {
+    const char* split = i == count ? end : data + size * i / count;
+    if (split < begin) {
+      continue;
+    }
+    // move the split behind the end of the line
+    const char* newline =
+        static_cast<const char*>(std::memchr(split, '\n', end - split));
+    split = newline == nullptr ? end : newline + 1;
+    chunks.push_back({begin, split});
+    begin = split;
+  }
+  return chunks;
+}
+
+/**
+ * Counts lines and edges of a chunk and checks that it contains only numbers
+ * and whitespace.
+ */
+void countChunk(Chunk& chunk, bool last) {
+  char previous = '\n';
+  for (const char* p = chunk.begin; p != chunk.end; ++p) {
+    char c = *p;
+    if (isDigit(c)) {
+      if (!isDigit(previous)) {
+        ++chunk.edges;
+      }
+    } else if (c == '\n') {
+      ++chunk.lines;
+    } else if (!isBlank(c)) {
+      throw std::invalid_argument("Unexpected character in graph file.");
+    }
+    previous = c;
+  }
+  // the last line does not have to be terminated
+  if (last && chunk.begin != chunk.end && previous != '\n') {
+    ++chunk.lines;
+  }
+}
+
+/**
+ * Parses a counted chunk to its place in the CSR arrays.
+ */
+void parseChunk(const Chunk& chunk,
+                std::vector<size_t>& offsets,
+                std::vector<size_t>& adjacency) {
+  size_t node = chunk.firstNode;
+  size_t edge = chunk.firstEdge;
+  const char* p = chunk.begin;
+  if (p != chunk.end) {
+    offsets[node] = edge;
+  }
+  while (p != chunk.end) {
+    if (isDigit(*p)) {
+      size_t value;
+      auto [next, error] = std::from_chars(p, chunk.end, value);
+      if (error != std::errc()) {
+        throw std::invalid_argument("Node number out of range.");
+      }
+      adjacency[edge++] = value;
+      p = next;
+      continue;
+    }
+    if (*p == '\n') {
+      ++node;
+      // the start of the next chunk is written by its own thread
+      if (p + 1 != chunk.end) {
+        offsets[node] = edge;
+      }
+    }
+    ++p;
+  }
+}
+
+bool isDimacs(const MappedFile& file) {
+  const char* p = file.data();
+  const char* end = p + file.size();
+  while (p != end && (isBlank(*p) || *p == '\n')) {
+    ++p;
+  }
+  return p != end && (*p == 'c' || *p == 'p');
+}
+
+Graph parseDimacs(const MappedFile& file, const std::string& filename) {
+  const char* p = file.data();
+  const char* end = p + file.size();
+  auto skipBlanks = [&] {
+    while (p != end && isBlank(*p)) {
+      ++p;
+    }
+  };
+  auto readNumber = [&](const char* what) {
+    skipBlanks();
+    size_t value;
+    auto [next, error] = std::from_chars(p, end, value);
+    if (error != std::errc()) {
+      throw std::invalid_argument(filename + ": expected " + what + ".");
+    }
+    p = next;
+    return value;
+  };
+
+  bool haveProblem = false;
+  size_t nodes = 0;
+  std::vector<std::pair<size_t, size_t>> edges;
+  while (p != end) {
+    skipBlanks();
+    char type = p == end ? '\n' : *p;
+    if (type == 'p') {
+      if (haveProblem) {
+        throw std::invalid_argument(filename + ": duplicate problem line.");
+      }
+      ++p;
+      skipBlanks();
+      while (p != end && !isBlank(*p) && *p != '\n') {
+        ++p;
+      }
+      nodes = readNumber("the node count");
+      // the header is not trusted further than the file: an edge line
+      // "e u v" takes at least 6 bytes
+      size_t edgeCount = readNumber("the edge count");
+      edges.reserve(std::min<size_t>(edgeCount, (end - p) / 6));
+      haveProblem = true;
+    } else if (type == 'e') {
+      if (!haveProblem) {
+        throw std::invalid_argument(filename + ": edge before problem line.");
+      }
+      ++p;
+      size_t a = readNumber("a node");
+      size_t b = readNumber("a node");
+      if (a == 0 || b == 0 || a > nodes || b > nodes) {
+        throw std::invalid_argument(filename + ": node out of range.");
+      }
+      edges.emplace_back(a - 1, b - 1);
+    } else if (type != 'c' && type != 'n' && type != '\n') {
+      throw std::invalid_argument(filename + ": unknown line type.");
+    }
+    // the rest of the line
+    const char* newline =
+        static_cast<const char*>(std::memchr(p, '\n', end - p));
+    p = newline == nullptr ? end : newline + 1;
+  }
+  if (!haveProblem) {
+    throw std::invalid_argument(filename + ": missing problem line.");
+  }
+
+  // CSR of the edges as listed, the graph makes them symmetric
+  std::vector<size_t> offsets(nodes + 1, 0);
+  for (auto&& edge : edges) {
+    ++offsets[edge.first + 1];
+  }
+  std::partial_sum(offsets.begin(), offsets.end(), offsets.begin());
+  std::vector<size_t> adjacency(edges.size());
+  std::vector<size_t> next(offsets.begin(), offsets.end() - 1);
+  for (auto&& edge : edges) {
+    adjacency[next[edge.first]++] = edge.second;
+  }
+  return Graph(offsets, adjacency);
+}
+
+constexpr char SNAPSHOT_MAGIC[8] = {'G', 'A', 'L', 'C', 'S', 'R', '\0', '\0'};
+constexpr uint32_t BYTE_ORDER_MARK = 0x01020304;
+
+static_assert(sizeof(size_t) == sizeof(uint64_t),
+              "snapshots store size_t values as 64 bit integers");
+static_assert(sizeof(SnapshotHeader) % sizeof(uint64_t) == 0,
+              "the arrays following the header must stay aligned");
+
+bool isSnapshot(const MappedFile& file) {
+  return file.size() >= sizeof(SnapshotHeader) &&
+         std::memcmp(file.data(), SNAPSHOT_MAGIC, sizeof(SNAPSHOT_MAGIC)) == 0;
+}
+
+Graph mapSnapshot(std::shared_ptr<const MappedFile> file,
+                  const std::string& filename,
+                  bool check,
+                  unsigned threads) {
+  if (!isSnapshot(*file)) {
+    throw std::invalid_argument(filename + " is not a graph snapshot.");
+  }
+  SnapshotHeader header;
+  std::memcpy(&header, file->data(), sizeof(header));
+  if (header.version != SNAPSHOT_VERSION) {
+    throw std::invalid_argument(filename + ": unsupported snapshot version.");
+  }
+  if (header.byteOrder != BYTE_ORDER_MARK) {
+    throw std::invalid_argument(filename + ": snapshot has wrong byte order.");
+  }
+  // the sizes must describe exactly the rest of the file
+  size_t values = (file->size() - sizeof(header)) / sizeof(size_t);
+  if ((file->size() - sizeof(header)) % sizeof(size_t) != 0 ||
+      header.nodeCount >= values ||
+      values - header.nodeCount - 1 != header.edgeCount) {
+    throw std::invalid_argument(filename + ": snapshot is truncated.");
+  }
+
+  auto data = reinterpret_cast<const size_t*>(file->data() + sizeof(header));
+  if (data[0] != 0 || data[header.nodeCount] != header.edgeCount) {
+    throw std::invalid_argument(filename + ": snapshot is corrupted.");
+  }
+  if (check) {
+    GAL_TRACE_SPAN("check snapshot");
+    // the offsets first, all of them: with 0 at the start, edgeCount at the
+    // end and no decrease, every edge list lies inside the adjacency
+    const size_t n = header.nodeCount;
+    std::atomic<bool> corrupted{false};
+    parallelBlocks(n, threads, [&](unsigned, size_t begin, size_t end) {
+      for (size_t i = begin; i < end; ++i) {
+        if (data[i] > data[i + 1]) {
+          corrupted = true;
+          return;
+        }
+      }
+    });
+    // only then the edges, which must point to nodes
+    const size_t* adjacency = data + n + 1;
+    if (!corrupted) {
+      parallelBlocks(header.edgeCount, threads,
+                     [&](unsigned, size_t begin, size_t end) {
+                       for (size_t e = begin; e < end; ++e) {
+                         if (adjacency[e] >= n) {
+                           corrupted = true;
+                           return;
+                         }
+                       }
+                     });
+    }
+    if (corrupted) {
+      throw std::invalid_argument(filename + ": snapshot is corrupted.");
+    }
+  }
+  std::shared_ptr<const size_t> offsets(file, data);
+  std::shared_ptr<const size_t> adjacency(file, data + header.nodeCount + 1);
+  return Graph(std::move(offsets),
+               std::move(adjacency),
+               header.nodeCount,
+               header.edgeCount);
+}
+
+}  // namespace
+
+void saveSnapshot(const Graph& graph, const std::string& filename) {
+  std::ofstream os(filename, std::ios::binary);
+  if (!os) {
+    throw std::runtime_error("Can not open " + filename + " for writing.");
+  }
+  SnapshotHeader header{};
+  std::memcpy(header.magic, SNAPSHOT_MAGIC, sizeof(SNAPSHOT_MAGIC));
+  header.version = SNAPSHOT_VERSION;
+  header.byteOrder = BYTE_ORDER_MARK;
+  header.nodeCount = graph.size();
+  header.edgeCount = graph.edgeCount();
+
+  auto offsets = graph.offsets();
+  auto adjacency = graph.adjacency();
+  os.write(reinterpret_cast<const char*>(&header), sizeof(header));
+  os.write(reinterpret_cast<const char*>(offsets.begin()),
+           offsets.size() * sizeof(size_t));
+  os.write(reinterpret_cast<const char*>(adjacency.begin()),
+           adjacency.size() * sizeof(size_t));
+  if (!os) {
+    throw std::runtime_error("Can not write " + filename + ".");
+  }
+}
+
+Graph loadSnapshot(const std::string& filename,
+                   bool check,
+                   unsigned threads) {
+  return mapSnapshot(std::make_shared<const MappedFile>(filename), filename,
+                     check, threads);
+}
+
+Graph loadDimacs(const std::string& filename) {
+  return parseDimacs(MappedFile(filename), filename);
+}
+
+Graph loadGraph(const std::string& filename, unsigned threads) {
+  GAL_TRACE_SPAN("load graph");
+  if (threads == 0) {
+    threads = defaultThreadCount();
+  }
+  auto mapping = std::make_shared<const MappedFile>(filename);
+  if (isSnapshot(*mapping)) {
+    return mapSnapshot(std::move(mapping), filename, true, threads);
+  }
+  if (isDimacs(*mapping)) {
+    return parseDimacs(*mapping, filename);
+  }
+  auto&& file = *mapping;
+  auto chunks = splitToChunks(file.data(), file.size(), threads);
+
+  {
+    GAL_TRACE_SPAN("count lines");
+    parallelFor(chunks.size(), threads, [&](size_t i) {
+      countChunk(chunks[i], i + 1 == chunks.size());
+    });
+  }
+
+  size_t nodes = 0;
+  size_t edges = 0;
+  for (auto&& chunk : chunks) {
+    chunk.firstNode = nodes;
+    chunk.firstEdge = edges;
+    nodes += chunk.lines;
+    edges += chunk.edges;
+  }
+
+  std::vector<size_t> offsets(nodes + 1);
+  std::vector<size_t> adjacency(edges);
+  offsets[nodes] = edges;
+  {
+    GAL_TRACE_SPAN("parse edges");
+    parallelFor(chunks.size(), threads, [&](size_t i) {
+      parseChunk(chunks[i], offsets, adjacency);
+    });
+  }
+
+  return Graph(offsets, adjacency, threads);
+}
+
+/*** End of file: graph_io.cpp ***/
@@ -8,45 +8,260 @@
 #include <fstream>
 #include <iostream>
 #include <memory>
+#include <optional>
 
 #include <benchmark.hpp>
 #include "coloring_alg.h"
+#include "exact_coloring.h"
 #include "graph.hpp"
+#include "graph_io.h"
+#include "parallel_coloring.h"
+#include "perf_counters.h"
+#include "random.h"
+#include "reordering.h"
+#include "sharded_coloring.h"
+#include "tabu_coloring.h"
+#include "trace.h"
+
+// the exact solver is run only on graphs up to this size
+inline constexpr size_t EXACT_MAX_NODES = 1000;
+
+/**
+ * Benchmarks CG, on relabeled copies of the graphs when an ordering is given,
+ * so that the relabeling is measured too. The name is printed and names the
+ * span of the whole measurement in the trace.
+ */
+template <typename CG>
+std::vector<BenchmarkResult> measure(const char* name,
+                                     const std::vector<Graph>& graphs,
+                                     std::optional<NodeOrdering> ordering,
+                                     const BenchmarkSettings& settings) {
+  std::cout << name << "\n";
+  GAL_TRACE_SPAN(name);
+  if (!ordering) {
+    return benchmark<CG>(graphs, settings);
+  }
+  switch (*ordering) {
+    case NodeOrdering::RCM:
+      return benchmark<RelabeledColoring<CG, NodeOrdering::RCM>>(graphs,
+                                                                 settings);
+    case NodeOrdering::BFS:
+      return benchmark<RelabeledColoring<CG, NodeOrdering::BFS>>(graphs,
+                                                                 settings);
+    case NodeOrdering::DEGREE:
+      return benchmark<RelabeledColoring<CG, NodeOrdering::DEGREE>>(graphs,
+                                                                    settings);
+  }
+  return benchmark<CG>(graphs, settings);
+}
 
 int main(int argc, char* argv[]) {
-  if (argc < 3) {
+  // options come before the input files
+  std::optional<NodeOrdering> ordering;
+  bool relabelCost = false;
+  BenchmarkSettings settings;
+  std::string jsonName;
+  std::string traceName;
+  bool badOption = false;
+  int first = 1;
+  for (; first < argc && argv[first][0] == '-' && argv[first][1] == '-';
+       ++first) {
+    std::string option = argv[first];
+    bool hasValue = first + 1 < argc;
+    try {
+      if (option == "--warmup" && hasValue) {
+        settings.warmupIterations = std::stoul(argv[++first]);
+        continue;
+      } else if (option == "--min-iterations" && hasValue) {
+        settings.minIterations = std::stoul(argv[++first]);
+        continue;
+      } else if (option == "--max-iterations" && hasValue) {
+        settings.maxIterations = std::stoul(argv[++first]);
+        continue;
+      } else if (option == "--target-ci" && hasValue) {
+        settings.targetRelativeCi = std::stod(argv[++first]);
+        continue;
+      } else if (option == "--max-time" && hasValue) {
+        settings.maxMilliseconds = std::stod(argv[++first]);
+        continue;
+      } else if (option == "--seed" && hasValue) {
+        settings.seed = std::stoull(argv[++first]);
+        continue;
+      }
+    } catch (std::exception&) {
+      badOption = true;
+      continue;
+    }
+    if (option == "--perf") {
+      settings.perfCounters = true;
+    } else if (option == "--json" && hasValue) {
+      jsonName = argv[++first];
+    } else if (option == "--trace" && hasValue) {
+      traceName = argv[++first];
+    } else if (option == "--relabel" && hasValue) {
+      std::string name = argv[++first];
+      if (name == "rcm") {
+        ordering = NodeOrdering::RCM;
+      } else if (name == "bfs") {
+        ordering = NodeOrdering::BFS;
+      } else if (name == "degree") {
+        ordering = NodeOrdering::DEGREE;
+      } else {
+        badOption = true;
+      }
+    } else if (option == "--include-relabel-cost") {
+      relabelCost = true;
+    } else if (option != "--help") {
+      badOption = true;
+    }
+  }
+  if (settings.maxIterations == 0 ||
+      settings.minIterations > settings.maxIterations) {
+    std::cerr << "error: --max-iterations must be positive and at least "
+                 "--min-iterations\n";
+    badOption = true;
+  }
+  if (argc - first < 2 || badOption) {
     std::cerr << "Usage:\n"
-                 "./gal2018 input.txt [input2.txt ...] output.csv\n"
+                 "./gal2018 [--relabel rcm|bfs|degree [--include-relabel-cost]]"
+                 " [--warmup n] [--min-iterations n] [--max-iterations n]"
+                 " [--target-ci fraction] [--max-time ms] [--json file]"
+                 " [--perf] [--trace file] [--seed n]"
+                 " input.txt [input2.txt ...] output.csv\n"
+                 "Each graph is colored --warmup times (1) untimed and then "
+                 "timed at least --min-iterations times (5) and until the "
+                 "95% confidence interval of the mean time is within "
+                 "--target-ci of the mean (0.02), --max-iterations runs (100)"
+                 " or --max-time milliseconds (10000) are reached. "
+                 "The CSV has the median times, all the statistics go to "
+                 "the JSON file, by default output.json, together with the "
+                 "heap allocations and peak RSS growth of the first run\n"
+                 "--seed sets the random seed (2018) before every run, so "
+                 "iterated greedy and tabucol repeat their results\n"
+                 "--perf reads hardware counters (cycles, instructions, L1D, "
+                 "LLC, dTLB and branch misses) around every timed run and "
+                 "writes their averages to output-perf.csv and the JSON file"
+                 "\n"
+                 "--trace records the loading, normalization, orderings, "
+                 "coloring runs and validation of every thread and writes "
+                 "them as Chrome trace JSON for chrome://tracing or Perfetto"
+                 "\n"
+                 "--relabel relabels the nodes in reverse Cuthill-McKee, "
+                 "breadth-first or decreasing degree order before coloring; "
+                 "the relabeling is done once up front unless "
+                 "--include-relabel-cost puts it into every measurement\n"
                  "This program produces a csv file with benchmarks for:"
-                 "greedy coloring\nlargest degree ordering coloring\nincidence "
-                 "degree coloring\n";
+                 "greedy coloring\ngreedy coloring with a set of colors\n"
+                 "largest degree ordering coloring\nincidence "
+                 "degree coloring\nSDO + LDO coloring\nsmallest last coloring\n"
+                 "parallel greedy coloring\nJones-Plassmann coloring\n"
+                 "greedy coloring improved by iterated greedy\n"
+                 "DSatur improved by tabucol (time, colors, moves per second)\n"
+                 "sharded coloring in 4 worker processes (time, colors, "
+                 "rounds, bytes exchanged)\n"
+                 "exact coloring of graphs with at most 1000 nodes (time, "
+                 "colors, lower bound, whether it is optimal, search nodes)\n"
+                 "and the degeneracy of each graph (smallest last coloring "
+                 "uses at most degeneracy + 1 colors)\n";
     if (argc == 2 && std::string(argv[1]) == "--help") {
       return 0;
     }
     return 1;
   }
+  if (settings.perfCounters) {
+    PerfCounters probe;
+    if (!probe.error().empty()) {
+      std::cerr << "warning: hardware counters unavailable: " << probe.error()
+                << "\n";
+    }
+  }
+
+  Tracer::enable(!traceName.empty());
+
   // load graphs from files
   std::vector<std::string> testNames;
-  std::vector<ColoredGraph> test;
-  for (int i = 1; i < argc - 1; ++i) {
-    std::ifstream fileStream(argv[i]);
-    if (!fileStream) {
-      std::cerr << "Can not open " << argv[i] << " for reading.\n";
+  std::vector<Graph> test;
+  for (int i = first; i < argc - 1; ++i) {
+    try {
+      test.push_back(loadGraph(argv[i]));
+    } catch (std::exception& e) {
+      std::cerr << argv[i] << ": " << e.what() << "\n";
       continue;
     }
-    test.push_back(ColoredGraph(fileStream));
     testNames.push_back(argv[i]);
   }
+  if (ordering && !relabelCost) {
+    GAL_TRACE_SPAN("relabel graphs");
+    for (auto&& graph : test) {
+      graph = relabelGraph(graph, localityOrdering(graph, *ordering));
+    }
+  }
+  // the ordering of measure(), only set when relabeling is measured
+  std::optional<NodeOrdering> timedOrdering;
+  if (relabelCost) {
+    timedOrdering = ordering;
+  }
 
-  std::cout << "Greedy Coloring\n";
-  auto greedyResults = benchmark<GreedyColoring>(test);
-  std::cout << "Largest Degree Ordering Coloring\n";
-  auto ldocResults = benchmark<LargestDegreeOrderingColoring>(test);
-  std::cout << "Incidence Degree Coloring\n";
-  auto idcResults = benchmark<IncidenceDegreeColoring>(test);
-  // pow(n, 3) complexity, way too large for sensible graphs
-  /*std::cout << "SDO + LDO Coloring\n";
-  auto sdoLdoResults = benchmark<SdoLdoColoring>(test);*/
+  auto greedyResults = measure<GreedyColoring>(
+      "Greedy Coloring", test, timedOrdering, settings);
+  auto greedySetResults = measure<GreedyColoringWithSet>(
+      "Greedy Coloring With Set", test, timedOrdering, settings);
+  auto parallelGreedyResults = measure<ParallelGreedyColoring>(
+      "Parallel Greedy Coloring", test, timedOrdering, settings);
+  auto jpResults = measure<JonesPlassmannColoring>(
+      "Jones-Plassmann Coloring", test, timedOrdering, settings);
+  auto igResults = measure<IteratedGreedyColoring>(
+      "Iterated Greedy Coloring", test, timedOrdering, settings);
+  auto ldocResults = measure<LargestDegreeOrderingColoring>(
+      "Largest Degree Ordering Coloring", test, timedOrdering, settings);
+  auto slResults = measure<SmallestLastColoring>(
+      "Smallest Last Coloring", test, timedOrdering, settings);
+  auto idcResults = measure<IncidenceDegreeColoring>(
+      "Incidence Degree Coloring", test, timedOrdering, settings);
+  auto sdoLdoResults = measure<SdoLdoColoring>(
+      "SDO + LDO Coloring", test, timedOrdering, settings);
+  auto tabuResults = measure<TabucolColoring>(
+      "Tabucol Coloring", test, timedOrdering, settings);
+  // one more run for the move throughput
+  std::vector<double> tabuMoveRates;
+  for (auto&& graph : test) {
+    Coloring coloring(graph.size());
+    gal_seed(settings.seed);
+    tabuMoveRates.push_back(
+        tabucolColoring(graph, coloring, 10'000'000, std::chrono::seconds(1))
+            .movesPerSecond);
+  }
+  auto shardedResults = measure<ShardedColoring>(
+      "Sharded Coloring", test, timedOrdering, settings);
+  // one more run for the communication
+  std::vector<ShardedColoringResult> shardedTraffic;
+  for (auto&& graph : test) {
+    Coloring coloring(graph.size());
+    shardedTraffic.push_back(shardedColoring(graph, coloring, 4));
+  }
+  // the graphs share their arrays with the copies
+  std::vector<Graph> small;
+  for (auto&& graph : test) {
+    if (graph.size() <= EXACT_MAX_NODES) {
+      small.push_back(graph);
+    }
+  }
+  auto exactTimes = measure<ExactColoring>(
+      "Exact Coloring", small, timedOrdering, settings);
+  // one more run for the bounds, the benchmark only keeps the colors
+  std::vector<std::optional<BenchmarkResult>> exactResults;
+  std::vector<ExactColoringResult> exactBounds;
+  for (size_t i = 0, j = 0; i < test.size(); ++i) {
+    if (test[i].size() > EXACT_MAX_NODES) {
+      exactResults.emplace_back();
+      exactBounds.emplace_back();
+      continue;
+    }
+    exactResults.emplace_back(exactTimes[j++]);
+    Coloring coloring(test[i].size());
+    exactBounds.push_back(
+        exactColoring(test[i], coloring, 10'000'000, std::chrono::seconds(1)));
+  }
 
   std::ofstream out(argv[argc - 1]);
   if (!out) {
@@ -55,12 +270,156 @@ int main(int argc, char* argv[]) {
   }
   // dump results
   out << "NAME,GREEDYTIME,GREEDYCOLORS,LDOCTIME,LDOCCOLORS,IDCTIME,IDCCOLORS,"
-         "\n";
+         "SDOLDOTIME,SDOLDOCOLORS,SLTIME,SLCOLORS,DEGENERACY,PGREEDYTIME,"
+         "PGREEDYCOLORS,JPTIME,JPCOLORS,IGTIME,IGCOLORS,EXACTTIME,EXACTCOLORS,"
+         "EXACTLOWERBOUND,EXACTOPTIMAL,EXACTNODES,TABUTIME,TABUCOLORS,"
+         "TABUMOVESPERSEC,SHARDTIME,SHARDCOLORS,SHARDROUNDS,SHARDBYTES,"
+         "GREEDYSETTIME,GREEDYSETCOLORS,\n";
   for (size_t i = 0; i < testNames.size(); ++i) {
     out << testNames[i] << ',' << greedyResults[i].median << ','
         << greedyResults[i].colorCount << ',' << ldocResults[i].median << ','
         << ldocResults[i].colorCount << ',' << idcResults[i].median << ','
-        << idcResults[i].colorCount << "\n";
+        << idcResults[i].colorCount << ',' << sdoLdoResults[i].median << ','
+        << sdoLdoResults[i].colorCount << ',' << slResults[i].median << ','
+        << slResults[i].colorCount << ',' << degeneracy(test[i]) << ','
+        << parallelGreedyResults[i].median << ','
+        << parallelGreedyResults[i].colorCount << ',' << jpResults[i].median
+        << ',' << jpResults[i].colorCount << ',' << igResults[i].median << ','
+        << igResults[i].colorCount << ',';
+    if (exactResults[i]) {
+      out << exactResults[i]->median << ',' << exactResults[i]->colorCount
+          << ',' << exactBounds[i].lowerBound << ','
+          << exactBounds[i].optimal << ',' << exactBounds[i].searchNodes;
+    } else {
+      out << ",,,,";
+    }
+    out << ',' << tabuResults[i].median << ',' << tabuResults[i].colorCount
+        << ',' << tabuMoveRates[i] << ',' << shardedResults[i].median << ','
+        << shardedResults[i].colorCount << ',' << shardedTraffic[i].rounds
+        << ','
+        << shardedTraffic[i].bytesSent + shardedTraffic[i].bytesReceived
+        << ',' << greedySetResults[i].median << ','
+        << greedySetResults[i].colorCount << "\n";
+  }
+
+  std::string csvName = argv[argc - 1];
+  size_t dot = csvName.rfind('.');
+  bool csvExtension = dot != std::string::npos && csvName.substr(dot) == ".csv";
+  std::string baseName = csvExtension ? csvName.substr(0, dot) : csvName;
+
+  if (settings.perfCounters) {
+    std::ofstream perf(baseName + "-perf.csv");
+    if (!perf) {
+      std::cerr << "Could not open " << baseName << "-perf.csv for writing.\n";
+      return 2;
+    }
+    perf << "NAME,ALGORITHM,CYCLES,INSTRUCTIONS,L1DMISSES,LLCMISSES,"
+            "BRANCHMISSES,DTLBMISSES,\n";
+    const std::pair<const char*, const std::vector<BenchmarkResult>*>
+        measured[] = {{"greedy", &greedyResults},
+                      {"greedyWithSet", &greedySetResults},
+                      {"largestDegreeOrdering", &ldocResults},
+                      {"incidenceDegree", &idcResults},
+                      {"sdoLdo", &sdoLdoResults},
+                      {"smallestLast", &slResults},
+                      {"parallelGreedy", &parallelGreedyResults},
+                      {"jonesPlassmann", &jpResults},
+                      {"iteratedGreedy", &igResults},
+                      {"tabucol", &tabuResults},
+                      {"sharded", &shardedResults}};
+    auto row = [&](size_t graph, const char* name,
+                   const BenchmarkResult& result) {
+      perf << testNames[graph] << ',' << name;
+      for (size_t e = 0; e < PERF_EVENT_COUNT; ++e) {
+        perf << ',';
+        if (result.perfValid[e]) {
+          perf << static_cast<uint64_t>(result.perf[e]);
+        }
+      }
+      perf << "\n";
+    };
+    for (size_t i = 0; i < testNames.size(); ++i) {
+      for (auto&& [name, results] : measured) {
+        row(i, name, (*results)[i]);
+      }
+      if (exactResults[i]) {
+        row(i, "exact", *exactResults[i]);
+      }
+    }
+  }
+
+  if (jsonName.empty()) {
+    jsonName = baseName + ".json";
+  }
+  std::ofstream json(jsonName);
+  if (!json) {
+    std::cerr << "Could not open " << jsonName << " for writing.\n";
+    return 2;
+  }
+  json << "{\n  \"settings\": {\"warmupIterations\": "
+       << settings.warmupIterations
+       << ", \"minIterations\": " << settings.minIterations
+       << ", \"maxIterations\": " << settings.maxIterations
+       << ", \"targetRelativeCi\": " << settings.targetRelativeCi
+       << ", \"maxMilliseconds\": " << settings.maxMilliseconds
+       << ", \"seed\": " << settings.seed << "},\n"
+       << "  \"unit\": \"ms\",\n  \"graphs\": [";
+  for (size_t i = 0; i < testNames.size(); ++i) {
+    json << (i == 0 ? "\n" : ",\n") << "    {\"name\": ";
+    writeJsonString(json, testNames[i]);
+    json << ", \"nodes\": " << test[i].size()
+         << ", \"edges\": " << test[i].edgeCount() / 2
+         << ", \"degeneracy\": " << degeneracy(test[i])
+         << ", \"algorithms\": {";
+    bool firstAlgorithm = true;
+    // extra() writes more members of the algorithm
+    auto algorithm = [&](const char* name,
+                         const BenchmarkResult& result,
+                         auto&& extra) {
+      json << (firstAlgorithm ? "\n" : ",\n") << "      \"" << name
+           << "\": {";
+      firstAlgorithm = false;
+      writeJsonMembers(json, result);
+      extra();
+      json << '}';
+    };
+    auto none = [] {};
+    algorithm("greedy", greedyResults[i], none);
+    algorithm("greedyWithSet", greedySetResults[i], none);
+    algorithm("largestDegreeOrdering", ldocResults[i], none);
+    algorithm("incidenceDegree", idcResults[i], none);
+    algorithm("sdoLdo", sdoLdoResults[i], none);
+    algorithm("smallestLast", slResults[i], none);
+    algorithm("parallelGreedy", parallelGreedyResults[i], none);
+    algorithm("jonesPlassmann", jpResults[i], none);
+    algorithm("iteratedGreedy", igResults[i], none);
+    algorithm("tabucol", tabuResults[i], [&] {
+      json << ", \"movesPerSecond\": " << tabuMoveRates[i];
+    });
+    algorithm("sharded", shardedResults[i], [&] {
+      json << ", \"rounds\": " << shardedTraffic[i].rounds
+           << ", \"bytesSent\": " << shardedTraffic[i].bytesSent
+           << ", \"bytesReceived\": " << shardedTraffic[i].bytesReceived;
+    });
+    if (exactResults[i]) {
+      algorithm("exact", *exactResults[i], [&] {
+        json << ", \"lowerBound\": " << exactBounds[i].lowerBound
+             << ", \"optimal\": "
+             << (exactBounds[i].optimal ? "true" : "false")
+             << ", \"searchNodes\": " << exactBounds[i].searchNodes;
+      });
+    }
+    json << "\n    }}";
+  }
+  json << "\n  ]\n}\n";
+
+  if (!traceName.empty()) {
+    std::ofstream trace(traceName);
+    if (!trace) {
+      std::cerr << "Could not open " << traceName << " for writing.\n";
+      return 2;
+    }
+    Tracer::writeChromeTrace(trace);
   }
   return 0;
 }
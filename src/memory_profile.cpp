@@ -0,0 +1,166 @@
+/**
+ * Project: gal
+ * @file memory_profile.cpp
+ * @date 17. 10. 2026
+ * @author xvitra00, xdocek09
+ * @brief Source file of module measuring memory use of the process.
+ */
+
+#include "memory_profile.h"
+
+#include <atomic>
+#include <cstdlib>
+#include <cstring>
+#include <fstream>
+#include <new>
+#include <string>
+
+namespace {
+
+std::atomic<bool> counting{false};
+std::atomic<size_t> allocationCount{0};
+std::atomic<size_t> allocationBytes{0};
+
+inline void count(size_t size) noexcept {
+  if (counting.load(std::memory_order_relaxed)) {
+    allocationCount.fetch_add(1, std::memory_order_relaxed);
+    allocationBytes.fetch_add(size, std::memory_order_relaxed);
+  }
+}
+
+inline void* allocate(size_t size) noexcept {
+  count(size);
+  return std::malloc(size == 0 ? 1 : size);
+}
+
+inline void* allocateAligned(size_t size, std::align_val_t alignment) noexcept {
+  count(size);
+  size_t align = static_cast<size_t>(alignment);
+  // aligned_alloc wants a multiple of the alignment
+  size = (size + align - 1) / align * align;
+  return std::aligned_alloc(align, size == 0 ? align : size);
+}
+
+/**
+ * Reads a "Name:   1234 kB" line of /proc/self/status in bytes.
+ */
+size_t statusValue(const char* name) {
+  std::ifstream status("/proc/self/status");
+  std::string line;
+  const size_t length = std::strlen(name);
+  while (std::getline(status, line)) {
+    if (line.compare(0, length, name) == 0 && line.size() > length &&
+        line[length] == ':') {
+      return std::strtoull(line.c_str() + length + 1, nullptr, 10) * 1024;
+    }
+  }
+  return 0;
+}
+
+}  // namespace
+
+void startAllocationCounting() {
+  allocationCount.store(0, std::memory_order_relaxed);
+  allocationBytes.store(0, std::memory_order_relaxed);
+  counting.store(true, std::memory_order_release);
+}
+
+AllocationStats stopAllocationCounting() {
+  counting.store(false, std::memory_order_release);
+  AllocationStats stats;
+  stats.count = allocationCount.load(std::memory_order_acquire);
+  stats.bytes = allocationBytes.load(std::memory_order_acquire);
+  return stats;
+}
+
+size_t residentSetSize() { return statusValue("VmRSS"); }
+
+size_t peakResidentSetSize() { return statusValue("VmHWM"); }
+
+bool resetPeakResidentSetSize() {
+  std::ofstream clearRefs("/proc/self/clear_refs");
+  clearRefs << "5\n";
+  clearRefs.flush();
+  return static_cast<bool>(clearRefs);
+}
+
+void* operator new(size_t size) {
+  void* p = allocate(size);
+  if (p == nullptr) {
+    throw std::bad_alloc();
+  }
+  return p;
+}
+
+void* operator new[](size_t size) {
+  void* p = allocate(size);
+  if (p == nullptr) {
+    throw std::bad_alloc();
+  }
+  return p;
+}
+
+void* operator new(size_t size, const std::nothrow_t&) noexcept {
+  return allocate(size);
+}
+
+void* operator new[](size_t size, const std::nothrow_t&) noexcept {
+  return allocate(size);
+}
+
+void* operator new(size_t size, std::align_val_t alignment) {
+  void* p = allocateAligned(size, alignment);
+  if (p == nullptr) {
+    throw std::bad_alloc();
+  }
+  return p;
+}
+
+void* operator new[](size_t size, std::align_val_t alignment) {
+  void* p = allocateAligned(size, alignment);
+  if (p == nullptr) {
+    throw std::bad_alloc();
+  }
+  return p;
+}
+
+void* operator new(size_t size,
+                   std::align_val_t alignment,
+                   const std::nothrow_t&) noexcept {
+  return allocateAligned(size, alignment);
+}
+
+void* operator new[](size_t size,
+                     std::align_val_t alignment,
+                     const std::nothrow_t&) noexcept {
+  return allocateAligned(size, alignment);
+}
+
+void operator delete(void* p) noexcept { std::free(p); }
+void operator delete[](void* p) noexcept { std::free(p); }
+void operator delete(void* p, size_t) noexcept { std::free(p); }
+void operator delete[](void* p, size_t) noexcept { std::free(p); }
+void operator delete(void* p, const std::nothrow_t&) noexcept { std::free(p); }
+void operator delete[](void* p, const std::nothrow_t&) noexcept {
+  std::free(p);
+}
+void operator delete(void* p, std::align_val_t) noexcept { std::free(p); }
+void operator delete[](void* p, std::align_val_t) noexcept { std::free(p); }
+void operator delete(void* p, size_t, std::align_val_t) noexcept {
+  std::free(p);
+}
+void operator delete[](void* p, size_t, std::align_val_t) noexcept {
+  std::free(p);
+}
+void operator delete(void* p,
+                     std::align_val_t,
+                     const std::nothrow_t&) noexcept {
+  std::free(p);
+}
+void operator delete[](void* p,
+                       std::align_val_t,
+                       const std::nothrow_t&) noexcept {
+  std::free(p);
+}
+
+/*** End of file: memory_profile.cpp ***/
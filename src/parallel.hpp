@@ -0,0 +1,113 @@
+/**
+ * Project: gal
+ * @file parallel.hpp
+ * @date 17. 10. 2026
+ * @author xvitra00, xdocek09
+ * @brief Minimal helpers for running loops on multiple threads.
+ */
+#ifndef GAL_PARALLEL_HPP
+#define GAL_PARALLEL_HPP
+
+#include <algorithm>
+#include <atomic>
+#include <exception>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+#include "trace.h"
+
+/**
+ * The number of threads used when the caller asks for 0 threads.
+ */
+inline unsigned defaultThreadCount() {
+  unsigned count = std::thread::hardware_concurrency();
+  return count == 0 ? 1 : count;
+}
+
+/**
+ * Runs f(thread) on threads threads and waits for all of them. The calling
+ * thread runs f(0). The first exception thrown by any f is rethrown.
+ *
+ * @param threads The number of threads, 0 means defaultThreadCount().
+ */
+template <typename F>
+void parallelRun(unsigned threads, F&& f) {
+  if (threads == 0) {
+    threads = defaultThreadCount();
+  }
+  if (threads == 1) {
+    f(0u);
+    return;
+  }
+  std::exception_ptr error;
+  std::mutex errorMutex;
+  auto guarded = [&](unsigned thread) {
+    GAL_TRACE_SPAN("parallel task");
+    try {
+      f(thread);
+    } catch (...) {
+      std::lock_guard<std::mutex> lock(errorMutex);
+      if (!error) {
+        error = std::current_exception();
+      }
+    }
+  };
+
+  std::vector<std::thread> workers;
+  workers.reserve(threads - 1);
+  for (unsigned t = 1; t < threads; ++t) {
+    workers.emplace_back(guarded, t);
+  }
+  guarded(0);
+  for (auto&& worker : workers) {
+    worker.join();
+  }
+  if (error) {
+    std::rethrow_exception(error);
+  }
+}
+
+/**
+ * Splits <0, size) into one contiguous block per thread and calls
+ * f(thread, begin, end) for each block in parallel.
+ *
+ * @param threads The number of threads, 0 means defaultThreadCount().
+ */
+template <typename F>
+void parallelBlocks(size_t size, unsigned threads, F&& f) {
+  if (threads == 0) {
+    threads = defaultThreadCount();
+  }
+  threads = static_cast<unsigned>(
+      std::max<size_t>(1, std::min<size_t>(threads, size)));
+  parallelRun(threads, [&](unsigned thread) {
+    size_t begin = size * thread / threads;
+    size_t end = size * (thread + 1) / threads;
+    f(thread, begin, end);
+  });
+}
+
+/**
+ * Calls f(task) for every task in <0, tasks). Tasks are handed out one by one
+ * to the threads, so uneven tasks are balanced.
+ *
+ * @param threads The number of threads, 0 means defaultThreadCount().
+ */
+template <typename F>
+void parallelFor(size_t tasks, unsigned threads, F&& f) {
+  if (threads == 0) {
+    threads = defaultThreadCount();
+  }
+  threads = static_cast<unsigned>(
+      std::max<size_t>(1, std::min<size_t>(threads, tasks)));
+  std::atomic<size_t> next{0};
+  parallelRun(threads, [&](unsigned) {
+    for (size_t task = next++; task < tasks; task = next++) {
+      f(task);
+    }
+  });
+}
+
+#endif
+/*** End of file: parallel.hpp ***/
@@ -0,0 +1,189 @@
+/**
+ * Project: gal
+ * @file parallel_coloring.cpp
+ * @date 17. 10. 2026
+ * @author xvitra00, xdocek09
+ * @brief Source file of module containing multithreaded coloring algorithms.
+ */
+
+#include "parallel_coloring.h"
+
+#include <algorithm>
+#include <atomic>
+#include <numeric>
+
+#include <random.h>
+#include "color_kernels.hpp"
+#include "parallel.hpp"
+#include "trace.h"
+
+void parallelGreedyColoring(const Graph& graph,
+                            Coloring& coloring,
+                            const std::vector<size_t>& nodesPermut,
+                            unsigned threads) {
+  if (threads == 0) {
+    threads = defaultThreadCount();
+  }
+  const size_t n = graph.size();
+  // the threads read colors of nodes that others may be writing
+  std::vector<std::atomic<size_t>> colors(n);
+  for (auto&& color : colors) {
+    color.store(Coloring::NO_COLOR, std::memory_order_relaxed);
+  }
+  auto colorOf = [&](size_t node) {
+    return colors[node].load(std::memory_order_relaxed);
+  };
+  // position of each node in the permutation decides conflicts
+  std::vector<size_t> rank(n);
+  for (size_t i = 0; i < nodesPermut.size(); ++i) {
+    rank[nodesPermut[i]] = i;
+  }
+
+  std::vector<StampColorKernel> kernels(threads, StampColorKernel(n));
+  std::vector<std::vector<size_t>> conflicts(threads);
+  std::vector<size_t> work = nodesPermut;
+  while (!work.empty()) {
+    // color speculatively
+    parallelBlocks(
+        work.size(), threads, [&](unsigned thread, size_t begin, size_t end) {
+          GAL_TRACE_SPAN("speculative coloring");
+          auto&& kernel = kernels[thread];
+          for (size_t i = begin; i < end; ++i) {
+            size_t node = work[i];
+            colors[node].store(
+                kernel.smallestUnusedOf(graph.neighbors(node), colorOf),
+                std::memory_order_relaxed);
+          }
+        });
+
+    // find the conflicts, the node later in the permutation gives way
+    parallelBlocks(
+        work.size(), threads, [&](unsigned thread, size_t begin, size_t end) {
+          GAL_TRACE_SPAN("conflict detection");
+          auto&& found = conflicts[thread];
+          found.clear();
+          for (size_t i = begin; i < end; ++i) {
+            size_t node = work[i];
+            size_t color = colorOf(node);
+            for (auto neighbor : graph.neighbors(node)) {
+              if (rank[neighbor] < rank[node] && colorOf(neighbor) == color) {
+                found.push_back(node);
+                break;
+              }
+            }
+          }
+        });
+
+    // blocks are contiguous, so the conflicts stay in the permutation order
+    size_t blocks = std::min<size_t>(threads, work.size());
+    work.clear();
+    for (size_t thread = 0; thread < blocks; ++thread) {
+      work.insert(work.end(), conflicts[thread].begin(), conflicts[thread].end());
+    }
+  }
+
+  coloring.colorCount() = 0;
+  for (size_t i = 0; i < n; ++i) {
+    coloring.color(i) = colorOf(i);
+    coloring.colorCount() = std::max(coloring.colorCount(), coloring.color(i));
+  }
+}
+
+void parallelGreedyColoring(const Graph& graph,
+                            Coloring& coloring,
+                            unsigned threads) {
+  std::vector<size_t> nodePerm(graph.size());
+  std::iota(nodePerm.begin(), nodePerm.end(), 0);
+
+  parallelGreedyColoring(graph, coloring, nodePerm, threads);
+}
+
+void jonesPlassmannColoring(const Graph& graph,
+                            Coloring& coloring,
+                            JonesPlassmannPriority priority,
+                            uint64_t seed,
+                            unsigned threads) {
+  if (threads == 0) {
+    threads = defaultThreadCount();
+  }
+  // frontier nodes handed to a thread at once
+  constexpr size_t CHUNK = 256;
+  const size_t n = graph.size();
+
+  // (major, minor, node id) is a strict total order
+  std::vector<std::pair<size_t, uint64_t>> key(n);
+  parallelBlocks(n, threads, [&](unsigned, size_t begin, size_t end) {
+    GAL_TRACE_SPAN("priorities");
+    for (size_t i = begin; i < end; ++i) {
+      key[i].first =
+          priority == JonesPlassmannPriority::LARGEST_DEGREE ? graph.degree(i)
+                                                             : 0;
+      key[i].second = GalRandom(seed, i)();
+    }
+  });
+  auto higher = [&](size_t a, size_t b) {
+    return key[a] > key[b] || (key[a] == key[b] && a < b);
+  };
+
+  // the number of uncolored neighbors with higher priority
+  std::vector<std::atomic<size_t>> waiting(n);
+  std::vector<std::vector<size_t>> ready(threads);
+  parallelBlocks(n, threads, [&](unsigned thread, size_t begin, size_t end) {
+    ready[thread].clear();
+    for (size_t i = begin; i < end; ++i) {
+      size_t count = 0;
+      for (auto neighbor : graph.neighbors(i)) {
+        count += higher(neighbor, i);
+      }
+      waiting[i].store(count, std::memory_order_relaxed);
+      if (count == 0) {
+        ready[thread].push_back(i);
+      }
+    }
+  });
+
+  coloring.clear();
+  std::vector<StampColorKernel> kernels(threads, StampColorKernel(n));
+  std::vector<size_t> frontier;
+  while (true) {
+    frontier.clear();
+    for (auto&& nodes : ready) {
+      frontier.insert(frontier.end(), nodes.begin(), nodes.end());
+      nodes.clear();
+    }
+    if (frontier.empty()) {
+      break;
+    }
+
+    std::atomic<size_t> nextChunk{0};
+    const size_t chunks = (frontier.size() + CHUNK - 1) / CHUNK;
+    parallelRun(std::min<size_t>(threads, chunks), [&](unsigned thread) {
+      GAL_TRACE_SPAN("color frontier");
+      auto&& kernel = kernels[thread];
+      for (size_t chunk = nextChunk++; chunk < chunks; chunk = nextChunk++) {
+        size_t end = std::min(frontier.size(), (chunk + 1) * CHUNK);
+        for (size_t i = chunk * CHUNK; i < end; ++i) {
+          size_t node = frontier[i];
+          // neighbors of higher priority are colored in earlier rounds, the
+          // others are not colored yet and no neighbor is in this round
+          coloring.color(node) =
+              kernel.smallestUnused(graph.neighbors(node), coloring);
+          for (auto neighbor : graph.neighbors(node)) {
+            if (higher(node, neighbor) &&
+                waiting[neighbor].fetch_sub(1, std::memory_order_acq_rel) ==
+                    1) {
+              ready[thread].push_back(neighbor);
+            }
+          }
+        }
+      }
+    });
+  }
+
+  coloring.colorCount() = 0;
+  for (size_t i = 0; i < n; ++i) {
+    coloring.colorCount() = std::max(coloring.colorCount(), coloring.color(i));
+  }
+}
+
+/*** End of file: parallel_coloring.cpp ***/
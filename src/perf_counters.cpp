@@ -0,0 +1,123 @@
+/**
+ * Project: gal
+ * @file perf_counters.cpp
+ * @date 17. 10. 2026
+ * @author xvitra00, xdocek09
+ * @brief Source file of module reading hardware performance counters.
+ */
+
+#include "perf_counters.h"
+
+#include <linux/perf_event.h>
+#include <sys/ioctl.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+
+#include <cerrno>
+#include <cstring>
+
+namespace {
+
+struct EventConfig {
+  uint32_t type;
+  uint64_t config;
+};
+
+constexpr uint64_t cacheEvent(uint64_t cache, uint64_t op, uint64_t result) {
+  return cache | (op << 8) | (result << 16);
+}
+
+constexpr std::array<EventConfig, PERF_EVENT_COUNT> EVENTS = {{
+    {PERF_TYPE_HARDWARE, PERF_COUNT_HW_CPU_CYCLES},
+    {PERF_TYPE_HARDWARE, PERF_COUNT_HW_INSTRUCTIONS},
+    {PERF_TYPE_HW_CACHE,
+     cacheEvent(PERF_COUNT_HW_CACHE_L1D,
+                PERF_COUNT_HW_CACHE_OP_READ,
+                PERF_COUNT_HW_CACHE_RESULT_MISS)},
+    {PERF_TYPE_HARDWARE, PERF_COUNT_HW_CACHE_MISSES},
+    {PERF_TYPE_HARDWARE, PERF_COUNT_HW_BRANCH_MISSES},
+    {PERF_TYPE_HW_CACHE,
+     cacheEvent(PERF_COUNT_HW_CACHE_DTLB,
+                PERF_COUNT_HW_CACHE_OP_READ,
+                PERF_COUNT_HW_CACHE_RESULT_MISS)},
+}};
+
+int openEvent(const EventConfig& event) {
+  perf_event_attr attr;
+  std::memset(&attr, 0, sizeof(attr));
+  attr.size = sizeof(attr);
+  attr.type = event.type;
+  attr.config = event.config;
+  attr.disabled = 1;
+  // threads started while counting are counted too
+  attr.inherit = 1;
+  attr.exclude_kernel = 1;
+  attr.exclude_hv = 1;
+  attr.read_format =
+      PERF_FORMAT_TOTAL_TIME_ENABLED | PERF_FORMAT_TOTAL_TIME_RUNNING;
+  return static_cast<int>(::syscall(SYS_perf_event_open, &attr, 0, -1, -1, 0));
+}
+
+}  // namespace
+
+PerfCounters::PerfCounters() {
+  for (size_t i = 0; i < PERF_EVENT_COUNT; ++i) {
+    fds_[i] = openEvent(EVENTS[i]);
+    if (fds_[i] < 0) {
+      if (!error_.empty()) {
+        error_ += ", ";
+      }
+      error_ += std::string(PERF_EVENT_NAMES[i]) + ": " + std::strerror(errno);
+    }
+  }
+}
+
+PerfCounters::~PerfCounters() {
+  for (int fd : fds_) {
+    if (fd >= 0) {
+      ::close(fd);
+    }
+  }
+}
+
+bool PerfCounters::available() const noexcept {
+  for (int fd : fds_) {
+    if (fd >= 0) {
+      return true;
+    }
+  }
+  return false;
+}
+
+void PerfCounters::start() {
+  for (int fd : fds_) {
+    if (fd >= 0) {
+      ::ioctl(fd, PERF_EVENT_IOC_RESET, 0);
+      ::ioctl(fd, PERF_EVENT_IOC_ENABLE, 0);
+    }
+  }
+}
+
+PerfSample PerfCounters::stop() {
+  for (int fd : fds_) {
+    if (fd >= 0) {
+      ::ioctl(fd, PERF_EVENT_IOC_DISABLE, 0);
+    }
+  }
+  PerfSample sample;
+  for (size_t i = 0; i < PERF_EVENT_COUNT; ++i) {
+    // value, time enabled, time running
+    uint64_t data[3];
+    if (fds_[i] < 0 || ::read(fds_[i], data, sizeof(data)) != sizeof(data) ||
+        data[2] == 0) {
+      continue;
+    }
+    double scale = data[2] < data[1] ? static_cast<double>(data[1]) / data[2]
+                                     : 1.0;
+    sample.values[i] = static_cast<uint64_t>(data[0] * scale);
+    sample.valid[i] = true;
+  }
+  return sample;
+}
+
+/*** End of file: perf_counters.cpp ***/
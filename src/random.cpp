@@ -1,43 +1,219 @@
 #include <random.h>
+#include <atomic>
+#include <cmath>
 #include <random>
 
-class RandClass {
+namespace {
+
+class RandState {
  public:
-  static RandClass& instance() {
-    static RandClass rs(std::random_device{}());
+  static RandState& instance() {
+    static RandState rs(std::random_device{}() ^
+                        (static_cast<uint64_t>(std::random_device{}()) << 32));
     return rs;
   }
 
-  std::mt19937_64 engine;
+  std::atomic<uint64_t> seed;
+  // incremented by every gal_seed(seed), restarts thread generators
+  std::atomic<uint64_t> generation{0};
+  // the next stream for a thread generator
+  std::atomic<uint64_t> nextStream{1};
 
  private:
-  RandClass(size_t seed) : engine(seed) {}
+  RandState(uint64_t seed) : seed(seed) {}
 };
+
+// streams of the thread generators, far from the task streams
+constexpr uint64_t THREAD_STREAM_BASE = uint64_t{1} << 63;
+
 /**
- * Get a random size_t in <0, upTo)
+ * The error of the Stirling approximation of log(k!).
+ */
+double stirlingCorrection(uint64_t k) {
+  static constexpr double TABLE[] = {
+      0.08106146679532726, 0.04134069595540929, 0.02767792568499834,
+      0.02079067210376509, 0.01664469118982119, 0.01387612882307075,
+      0.01189670994589177, 0.01041126526197209, 0.009255462182712733,
+      0.008330563433362871};
+  if (k < 10) {
+    return TABLE[k];
+  }
+  const double k1 = k + 1.0;
+  const double k2 = k1 * k1;
+  return (1.0 / 12 - (1.0 / 360 - 1.0 / 1260 / k2) / k2) / k1;
+}
+
+/**
+ * Binomial draw by inversion, for probability <= 0.5 and a small mean.
  */
-size_t gal_rand(size_t upTo) {
-  std::uniform_int_distribution<size_t> dis(0, upTo - 1);
-  return dis(RandClass::instance().engine);
+uint64_t binomialInversion(GalRandom& random, uint64_t n, double p) {
+  const double q = 1.0 - p;
+  const double s = p / q;
+  const double a = (n + 1) * s;
+  const double r0 = std::pow(q, static_cast<double>(n));
+  while (true) {
+    double r = r0;
+    double u = random.uniformReal();
+    uint64_t x = 0;
+    while (u > r && x <= n) {
+      u -= r;
+      ++x;
+      r *= a / x - s;
+    }
+    // rounding can leave u above the whole distribution, then draw again
+    if (x <= n) {
+      return x;
+    }
+  }
+}
+
+/**
+ * Binomial draw by BTRD (W. Hormann, The generation of binomial random
+ * variates, 1993), for probability <= 0.5 and a mean of at least 10.
+ */
+uint64_t binomialBtrd(GalRandom& random, uint64_t n, double p) {
+  const double nd = static_cast<double>(n);
+  const double q = 1.0 - p;
+  const double m = std::floor((nd + 1) * p);
+  const double r = p / q;
+  const double nr = (nd + 1) * r;
+  const double npq = nd * p * q;
+  const double sq = std::sqrt(npq);
+  const double b = 1.15 + 2.53 * sq;
+  const double a = -0.0873 + 0.0248 * b + 0.01 * p;
+  const double c = nd * p + 0.5;
+  const double alpha = (2.83 + 5.1 / b) * sq;
+  const double vr = 0.92 - 4.2 / b;
+  const double urvr = 0.86 * vr;
+  const uint64_t mi = static_cast<uint64_t>(m);
+
+  while (true) {
+    double v = random.uniformReal();
+    double u;
+    if (v <= urvr) {
+      u = v / vr - 0.43;
+      return static_cast<uint64_t>(
+          std::floor((2 * a / (0.5 - std::abs(u)) + b) * u + c));
+    }
+    if (v >= vr) {
+      u = random.uniformReal() - 0.5;
+    } else {
+      u = v / vr - 0.93;
+      u = std::copysign(0.5, u) - u;
+      v = random.uniformReal() * vr;
+    }
+    const double us = 0.5 - std::abs(u);
+    const double kd = std::floor((2 * a / us + b) * u + c);
+    if (kd < 0 || kd > nd) {
+      continue;
+    }
+    const uint64_t k = static_cast<uint64_t>(kd);
+    v = v * alpha / (a / (us * us) + b);
+    const double km = std::abs(kd - m);
+    if (km <= 15) {
+      // the ratio of the probabilities of k and m, term by term
+      double f = 1.0;
+      for (uint64_t i = mi + 1; i <= k; ++i) {
+        f *= nr / i - r;
+      }
+      for (uint64_t i = k + 1; i <= mi; ++i) {
+        v *= nr / i - r;
+      }
+      if (v <= f) {
+        return k;
+      }
+      continue;
+    }
+    // squeeze before the exact logarithmic test
+    v = std::log(v);
+    const double rho =
+        (km / npq) * (((km / 3 + 0.625) * km + 1.0 / 6) / npq + 0.5);
+    const double t = -km * km / (2 * npq);
+    if (v < t - rho) {
+      return k;
+    }
+    if (v > t + rho) {
+      continue;
+    }
+    const double nm = nd - m + 1;
+    const double h = (m + 0.5) * std::log((m + 1) / (r * nm)) +
+                     stirlingCorrection(mi) + stirlingCorrection(n - mi);
+    const double nk = nd - kd + 1;
+    if (v <= h + (nd + 1) * std::log(nm / nk) +
+                 (kd + 0.5) * std::log(nk * r / (kd + 1)) -
+                 stirlingCorrection(k) - stirlingCorrection(n - k)) {
+      return k;
+    }
+  }
+}
+
+}  // namespace
+
+uint64_t GalRandom::binomial(uint64_t trials, double probability) {
+  if (trials == 0 || !(probability > 0.0)) {
+    return 0;
+  }
+  if (probability >= 1.0) {
+    return trials;
+  }
+  // both methods need the smaller of the two probabilities
+  if (probability > 0.5) {
+    return trials - binomial(trials, 1.0 - probability);
+  }
+  if (trials * probability < 10.0) {
+    return binomialInversion(*this, trials, probability);
+  }
+  return binomialBtrd(*this, trials, probability);
+}
+
+void gal_seed(uint64_t seed) {
+  auto&& state = RandState::instance();
+  state.seed.store(seed);
+  state.nextStream.store(1);
+  state.generation.fetch_add(1);
+}
+
+uint64_t gal_seed() { return RandState::instance().seed.load(); }
+
+GalRandom gal_stream(uint64_t stream) { return GalRandom(gal_seed(), stream); }
+
+GalRandom& gal_thread_random() {
+  auto&& state = RandState::instance();
+  // the first stream belongs to the thread that asks first, normally main;
+  // the others are numbered as they come, so they are not reproducible
+  static std::atomic<bool> mainTaken{false};
+  thread_local bool isMain = !mainTaken.exchange(true);
+  thread_local uint64_t generation = ~uint64_t{0};
+  thread_local GalRandom random(0);
+
+  uint64_t current = state.generation.load();
+  if (generation != current) {
+    generation = current;
+    uint64_t stream = isMain ? 0 : state.nextStream++;
+    random = GalRandom(state.seed.load(), THREAD_STREAM_BASE + stream);
+  }
+  return random;
 }
+
+/**
+ * Get a random size_t in <0, upTo)
+ */
+size_t gal_rand(size_t upTo) { return gal_thread_random().uniform(upTo); }
 /**
  * Get a random size_t in <from, upTo)
  */
 size_t gal_rand(size_t from, size_t upTo) {
-  std::uniform_int_distribution<size_t> dis(from, upTo - 1);
-  return dis(RandClass::instance().engine);
+  return from + gal_thread_random().uniform(upTo - from);
 }
 /**
  * Get a random double in <0, upTo)
  */
 double gal_rand(double upTo) {
-  std::uniform_real_distribution dis(0.0, upTo);
-  return dis(RandClass::instance().engine);
+  return gal_thread_random().uniformReal() * upTo;
 }
 /**
  * Get a random double in <from, upTo)
  */
 double gal_rand(double from, double upTo) {
-  std::uniform_real_distribution dis(from, upTo);
-  return dis(RandClass::instance().engine);
-}
\ No newline at end of file
+  return from + gal_thread_random().uniformReal() * (upTo - from);
+}
@@ -0,0 +1,156 @@
+/**
+ * Project: gal
+ * @file reordering.cpp
+ * @date 17. 10. 2026
+ * @author xvitra00, xdocek09
+ * @brief Source file of module relabeling nodes for better memory locality.
+ */
+
+#include "reordering.h"
+
+#include <algorithm>
+#include <memory>
+#include <stdexcept>
+
+namespace {
+
+/**
+ * Breadth-first search over all components. Every component starts at the
+ * unvisited node chosen by start(), the neighbors of a node are visited in
+ * the order given by sortNeighbors().
+ */
+template <typename Start, typename SortNeighbors>
+std::vector<size_t> breadthFirstOrder(const Graph& graph,
+                                      Start&& start,
+                                      SortNeighbors&& sortNeighbors) {
+  const size_t n = graph.size();
+  std::vector<size_t> order;
+  order.reserve(n);
+  std::vector<bool> visited(n, false);
+  std::vector<size_t> found;
+  for (size_t next = 0; order.size() < n;) {
+    while (visited[next]) {
+      ++next;
+    }
+    size_t root = start(next, visited);
+    visited[root] = true;
+    // the order itself is the queue
+    size_t head = order.size();
+    order.push_back(root);
+    for (; head < order.size(); ++head) {
+      found.clear();
+      for (auto neighbor : graph.neighbors(order[head])) {
+        if (!visited[neighbor]) {
+          visited[neighbor] = true;
+          found.push_back(neighbor);
+        }
+      }
+      sortNeighbors(found);
+      order.insert(order.end(), found.begin(), found.end());
+    }
+  }
+  return order;
+}
+
+}  // namespace
+
+std::vector<size_t> localityOrdering(const Graph& graph,
+                                     NodeOrdering ordering) {
+  const size_t n = graph.size();
+  switch (ordering) {
+    case NodeOrdering::RCM: {
+      // the unvisited node of the smallest degree starts a component
+      std::vector<size_t> byDegree(n);
+      for (size_t i = 0; i < n; ++i) {
+        byDegree[i] = i;
+      }
+      auto byIncreasingDegree = [&](size_t a, size_t b) {
+        return graph.degree(a) < graph.degree(b);
+      };
+      std::stable_sort(byDegree.begin(), byDegree.end(), byIncreasingDegree);
+      size_t position = 0;
+      auto order = breadthFirstOrder(
+          graph,
+          [&](size_t, const std::vector<bool>& visited) {
+            while (visited[byDegree[position]]) {
+              ++position;
+            }
+            return byDegree[position];
+          },
+          [&](std::vector<size_t>& nodes) {
+            std::stable_sort(nodes.begin(), nodes.end(), byIncreasingDegree);
+          });
+      std::reverse(order.begin(), order.end());
+      return order;
+    }
+    case NodeOrdering::BFS:
+      return breadthFirstOrder(
+          graph, [](size_t next, const std::vector<bool>&) { return next; },
+          [](std::vector<size_t>&) {});
+    case NodeOrdering::DEGREE: {
+      // counting sort by decreasing degree keeps the ids of equal degrees in
+      // order
+      size_t maxDegree = 0;
+      for (size_t i = 0; i < n; ++i) {
+        maxDegree = std::max(maxDegree, graph.degree(i));
+      }
+      std::vector<size_t> start(maxDegree + 2, 0);
+      for (size_t i = 0; i < n; ++i) {
+        ++start[maxDegree - graph.degree(i) + 1];
+      }
+      for (size_t d = 1; d < start.size(); ++d) {
+        start[d] += start[d - 1];
+      }
+      std::vector<size_t> order(n);
+      for (size_t i = 0; i < n; ++i) {
+        order[start[maxDegree - graph.degree(i)]++] = i;
+      }
+      return order;
+    }
+  }
+  throw std::invalid_argument("Unknown node ordering.");
+}
+
+Graph relabelGraph(const Graph& graph, const std::vector<size_t>& order) {
+  const size_t n = graph.size();
+  if (order.size() != n) {
+    throw std::invalid_argument("The order is not a permutation of nodes.");
+  }
+  std::vector<size_t> newId(n, n);
+  for (size_t i = 0; i < n; ++i) {
+    if (order[i] >= n || newId[order[i]] != n) {
+      throw std::invalid_argument("The order is not a permutation of nodes.");
+    }
+    newId[order[i]] = i;
+  }
+
+  auto offsets = std::make_shared<std::vector<size_t>>(n + 1, 0);
+  auto adjacency = std::make_shared<std::vector<size_t>>(graph.edgeCount());
+  for (size_t i = 0; i < n; ++i) {
+    (*offsets)[i + 1] = (*offsets)[i] + graph.degree(order[i]);
+  }
+  // the edges are symmetric: going through the new ids in order and adding
+  // each one to the lists of its neighbors leaves every list sorted
+  std::vector<size_t> next(offsets->begin(), offsets->end() - 1);
+  for (size_t i = 0; i < n; ++i) {
+    for (auto neighbor : graph.neighbors(order[i])) {
+      (*adjacency)[next[newId[neighbor]]++] = i;
+    }
+  }
+
+  return Graph(std::shared_ptr<const size_t>(offsets, offsets->data()),
+               std::shared_ptr<const size_t>(adjacency, adjacency->data()),
+               n,
+               graph.edgeCount());
+}
+
+void mapColorsBack(const Coloring& relabeled,
+                   const std::vector<size_t>& order,
+                   Coloring& original) {
+  for (size_t i = 0; i < order.size(); ++i) {
+    original.color(order[i]) = relabeled.color(i);
+  }
+  original.colorCount() = relabeled.colorCount();
+}
+
+/*** End of file: reordering.cpp ***/
@@ -0,0 +1,592 @@
+/**
+ * Project: gal
+ * @file sharded_coloring.cpp
+ * @date 17. 10. 2026
+ * @author xvitra00, xdocek09
+ * @brief Source file of module coloring graph shards in worker processes.
+ */
+
+#include "sharded_coloring.h"
+
+#include <sys/socket.h>
+#include <sys/types.h>
+#include <sys/wait.h>
+#include <unistd.h>
+
+#include <algorithm>
+#include <cerrno>
+#include <deque>
+#include <stdexcept>
+#include <string>
+#include <unordered_map>
+
+#include "graph_io.h"
+#include "parallel.hpp"
+
+namespace {
+
+enum MessageTag : size_t { ROUND = 1, FINISH = 2 };
+
+/**
+ * One end of a socket pair carrying messages of size_t values, each one
+ * prefixed with its length.
+ */
+class Channel {
+ public:
+  explicit Channel(int fd) : fd_(fd) {}
+
+  void send(const std::vector<size_t>& message) {
+    size_t length = message.size();
+    write(&length, sizeof(length));
+    write(message.data(), length * sizeof(size_t));
+  }
+
+  std::vector<size_t> receive() {
+    size_t length;
+    read(&length, sizeof(length));
+    std::vector<size_t> message(length);
+    read(message.data(), length * sizeof(size_t));
+    return message;
+  }
+
+  size_t bytesSent() const noexcept { return sent_; }
+  size_t bytesReceived() const noexcept { return received_; }
+
+ private:
+  void write(const void* data, size_t size) {
+    auto bytes = static_cast<const char*>(data);
+    while (size != 0) {
+      // no SIGPIPE when the other side is gone
+      ssize_t done = ::send(fd_, bytes, size, MSG_NOSIGNAL);
+      if (done < 0 && errno == EINTR) {
+        continue;
+      }
+      if (done <= 0) {
+        throw std::runtime_error("Can not write to a worker channel.");
+      }
+      bytes += done;
+      size -= done;
+      sent_ += done;
+    }
+  }
+
+  void read(void* data, size_t size) {
+    auto bytes = static_cast<char*>(data);
+    while (size != 0) {
+      ssize_t done = ::read(fd_, bytes, size);
+      if (done < 0 && errno == EINTR) {
+        continue;
+      }
+      if (done <= 0) {
+        throw std::runtime_error("Can not read from a worker channel.");
+      }
+      bytes += done;
+      size -= done;
+      received_ += done;
+    }
+  }
+
+  int fd_;
+  size_t sent_ = 0;
+  size_t received_ = 0;
+};
+
+/**
+ * The worker side: one shard, the global ids of its nodes and the colors of
+ * its neighbors in other shards, which the coordinator broadcasts.
+ */
+class ShardWorker {
+ public:
+  /**
+   * @param[in] snapshot	The snapshot to read the shard from, or nullptr
+   * when the coordinator sends the shard.
+   */
+  ShardWorker(Channel& channel, const std::string* snapshot)
+      : channel_(channel), snapshot_(snapshot) {}
+
+  void run() {
+    if (snapshot_ != nullptr) {
+      auto range = channel_.receive();
+      // only the pages of the range are read, the mapping ends here
+      loadRange(loadSnapshot(*snapshot_, false), range.at(0), range.at(1));
+    } else {
+      load(channel_.receive());
+    }
+    for (auto ghost : ghosts_) {
+      ghostColors_.emplace(ghost, Coloring::NO_COLOR);
+    }
+    // (local id, color) of the boundary nodes
+    std::vector<size_t> reply;
+    for (size_t i = 0; i < size(); ++i) {
+      colors_[i] = freeColor(i);
+    }
+    for (size_t i = 0; i < size(); ++i) {
+      if (ghostOffsets_[i] != ghostOffsets_[i + 1]) {
+        reply.push_back(i);
+        reply.push_back(colors_[i]);
+      }
+    }
+    channel_.send(reply);
+
+    while (true) {
+      auto message = channel_.receive();
+      if (message.empty() || message[0] == FINISH) {
+        channel_.send(colors_);
+        return;
+      }
+      // ROUND, changed colors (global id, color) of all shards
+      size_t updates = message.at(1);
+      for (size_t i = 0, p = 2; i < updates; ++i, p += 2) {
+        auto it = ghostColors_.find(message.at(p));
+        if (it != ghostColors_.end()) {
+          it->second = message.at(p + 1);
+        }
+      }
+      // of two equally colored neighbors the larger id gives way
+      reply.clear();
+      for (size_t i = 0; i < size(); ++i) {
+        for (size_t e = ghostOffsets_[i]; e < ghostOffsets_[i + 1]; ++e) {
+          if (ghosts_[e] < ids_[i] &&
+              ghostColors_[ghosts_[e]] == colors_[i]) {
+            colors_[i] = freeColor(i);
+            reply.push_back(i);
+            reply.push_back(colors_[i]);
+            break;
+          }
+        }
+      }
+      channel_.send(reply);
+    }
+  }
+
+ private:
+  size_t size() const noexcept { return colors_.size(); }
+
+  // nodes, then for each node its global id, its inner edges and its edges
+  // to other shards
+  void load(const std::vector<size_t>& shard) {
+    size_t p = 0;
+    size_t nodes = shard.at(p++);
+    offsets_.assign(1, 0);
+    ghostOffsets_.assign(1, 0);
+    for (size_t i = 0; i < nodes; ++i) {
+      ids_.push_back(shard.at(p++));
+      size_t inner = shard.at(p++);
+      adjacency_.insert(adjacency_.end(), shard.begin() + p,
+                        shard.begin() + p + inner);
+      p += inner;
+      offsets_.push_back(adjacency_.size());
+      size_t outer = shard.at(p++);
+      ghosts_.insert(ghosts_.end(), shard.begin() + p,
+                     shard.begin() + p + outer);
+      p += outer;
+      ghostOffsets_.push_back(ghosts_.size());
+    }
+    colors_.assign(nodes, Coloring::NO_COLOR);
+  }
+
+  // the nodes <begin, end) of the graph, which are checked on the way as the
+  // snapshot was mapped without checks
+  void loadRange(const Graph& graph, size_t begin, size_t end) {
+    auto offsets = graph.offsets();
+    if (begin > end || end > graph.size()) {
+      throw std::invalid_argument("Shard out of the graph.");
+    }
+    offsets_.assign(1, 0);
+    ghostOffsets_.assign(1, 0);
+    for (size_t node = begin; node < end; ++node) {
+      if (offsets[node] > offsets[node + 1] ||
+          offsets[node + 1] > graph.edgeCount()) {
+        throw std::invalid_argument("Snapshot is corrupted.");
+      }
+      ids_.push_back(node);
+      for (auto neighbor : graph.neighbors(node)) {
+        if (neighbor >= graph.size()) {
+          throw std::invalid_argument("Snapshot is corrupted.");
+        }
+        if (begin <= neighbor && neighbor < end) {
+          adjacency_.push_back(neighbor - begin);
+        } else {
+          ghosts_.push_back(neighbor);
+        }
+      }
+      offsets_.push_back(adjacency_.size());
+      ghostOffsets_.push_back(ghosts_.size());
+    }
+    colors_.assign(end - begin, Coloring::NO_COLOR);
+  }
+
+  // the smallest color unused by the known neighbors
+  size_t freeColor(size_t node) {
+    const size_t limit = offsets_[node + 1] - offsets_[node] +
+                         ghostOffsets_[node + 1] - ghostOffsets_[node] + 2;
+    used_.assign(limit, false);
+    for (size_t i = offsets_[node]; i < offsets_[node + 1]; ++i) {
+      used_[std::min(colors_[adjacency_[i]], limit - 1)] = true;
+    }
+    for (size_t i = ghostOffsets_[node]; i < ghostOffsets_[node + 1]; ++i) {
+      auto it = ghostColors_.find(ghosts_[i]);
+      if (it != ghostColors_.end()) {
+        used_[std::min(it->second, limit - 1)] = true;
+      }
+    }
+    size_t color = Coloring::FIRST_COLOR;
+    while (used_[color]) {
+      ++color;
+    }
+    return color;
+  }
+
+  Channel& channel_;
+  const std::string* snapshot_;
+  std::vector<size_t> ids_;
+  std::vector<size_t> offsets_;
+  std::vector<size_t> adjacency_;
+  std::vector<size_t> ghostOffsets_;
+  std::vector<size_t> ghosts_;
+  std::unordered_map<size_t, size_t> ghostColors_;
+  std::vector<size_t> colors_;
+  std::vector<bool> used_;
+};
+
+/**
+ * Forked worker processes. Closing the channels makes the workers exit, so
+ * they are never left behind, not even on an exception.
+ */
+class WorkerPool {
+ public:
+  /**
+   * @param[in] snapshot	The snapshot the workers read their shards from,
+   * nullptr when the shards are sent to them.
+   */
+  WorkerPool(unsigned workers, const std::string* snapshot) {
+    try {
+      start(workers, snapshot);
+    } catch (...) {
+      stop();
+      throw;
+    }
+  }
+
+  ~WorkerPool() { stop(); }
+
+  Channel& operator[](size_t worker) { return channels_[worker]; }
+  size_t size() const noexcept { return channels_.size(); }
+
+  /**
+   * Closes the channels and waits for the workers.
+   *
+   * @throw std::runtime_error When a worker failed.
+   */
+  void join() {
+    for (int fd : fds_) {
+      ::close(fd);
+    }
+    fds_.clear();
+    bool failed = false;
+    for (pid_t pid : pids_) {
+      int status = 0;
+      pid_t done;
+      while ((done = ::waitpid(pid, &status, 0)) < 0 && errno == EINTR) {
+      }
+      failed |= done < 0 || !WIFEXITED(status) || WEXITSTATUS(status) != 0;
+    }
+    pids_.clear();
+    if (failed) {
+      throw std::runtime_error("A coloring worker failed.");
+    }
+  }
+
+  size_t bytesSent() const noexcept {
+    size_t bytes = 0;
+    for (auto&& channel : channels_) {
+      bytes += channel.bytesSent();
+    }
+    return bytes;
+  }
+
+  size_t bytesReceived() const noexcept {
+    size_t bytes = 0;
+    for (auto&& channel : channels_) {
+      bytes += channel.bytesReceived();
+    }
+    return bytes;
+  }
+
+ private:
+  void stop() noexcept {
+    try {
+      join();
+    } catch (...) {
+    }
+  }
+
+  void start(unsigned workers, const std::string* snapshot) {
+    for (unsigned w = 0; w < workers; ++w) {
+      int fds[2];
+      if (::socketpair(AF_UNIX, SOCK_STREAM, 0, fds) != 0) {
+        throw std::runtime_error("Can not create a worker channel.");
+      }
+      pid_t pid = ::fork();
+      if (pid < 0) {
+        ::close(fds[0]);
+        ::close(fds[1]);
+        throw std::runtime_error("Can not start a worker process.");
+      }
+      if (pid == 0) {
+        // the channels of the other workers belong to the coordinator
+        for (int fd : fds_) {
+          ::close(fd);
+        }
+        ::close(fds[0]);
+        int status = 0;
+        try {
+          Channel channel(fds[1]);
+          ShardWorker(channel, snapshot).run();
+        } catch (...) {
+          status = 1;
+        }
+        ::_exit(status);
+      }
+      ::close(fds[1]);
+      fds_.push_back(fds[0]);
+      pids_.push_back(pid);
+      channels_.emplace_back(fds[0]);
+    }
+  }
+
+  std::vector<int> fds_;
+  std::vector<pid_t> pids_;
+  std::vector<Channel> channels_;
+};
+
+}  // namespace
+
+std::vector<unsigned> partitionGraph(const Graph& graph,
+                                     unsigned shards,
+                                     ShardPartition partition) {
+  const size_t n = graph.size();
+  std::vector<unsigned> owner(n, 0);
+  if (shards <= 1 || n == 0) {
+    return owner;
+  }
+  if (partition == ShardPartition::RANGES) {
+    // every node weighs 1 + its degree
+    const size_t total = n + graph.edgeCount();
+    size_t weight = 0;
+    unsigned shard = 0;
+    for (size_t i = 0; i < n; ++i) {
+      while (shard + 1 < shards && weight >= total * (shard + 1) / shards) {
+        ++shard;
+      }
+      owner[i] = shard;
+      weight += 1 + graph.degree(i);
+    }
+    return owner;
+  }
+
+  // each shard takes the next nodes found by the search
+  const size_t target = (n + shards - 1) / shards;
+  std::vector<bool> found(n, false);
+  std::deque<size_t> queue;
+  unsigned shard = 0;
+  size_t filled = 0;
+  auto take = [&](size_t node) {
+    found[node] = true;
+    owner[node] = shard;
+    if (++filled == target && shard + 1 < shards) {
+      ++shard;
+      filled = 0;
+    }
+    queue.push_back(node);
+  };
+  for (size_t start = 0; start < n; ++start) {
+    if (found[start]) {
+      continue;
+    }
+    take(start);
+    while (!queue.empty()) {
+      size_t node = queue.front();
+      queue.pop_front();
+      for (auto neighbor : graph.neighbors(node)) {
+        if (!found[neighbor]) {
+          take(neighbor);
+        }
+      }
+    }
+  }
+  return owner;
+}
+
+namespace {
+
+/**
+ * The shards of the workers: the nodes of each shard and the local id of
+ * every node in its shard.
+ */
+struct Shards {
+  Shards(const std::vector<unsigned>& owner, unsigned workers)
+      : nodes(workers), local(owner.size()) {
+    for (size_t i = 0; i < owner.size(); ++i) {
+      local[i] = nodes[owner[i]].size();
+      nodes[owner[i]].push_back(i);
+    }
+  }
+
+  std::vector<std::vector<size_t>> nodes;
+  std::vector<size_t> local;
+};
+
+/**
+ * The coordinator after the shards were handed out: collects the first
+ * colors of the boundary nodes and broadcasts the changed colors in rounds
+ * until no worker recolors a node, then collects all colors. It never reads
+ * the graph.
+ */
+ShardedColoringResult coordinate(const Shards& shards,
+                                 WorkerPool& pool,
+                                 Coloring& coloring) {
+  const unsigned workers = static_cast<unsigned>(pool.size());
+  const size_t n = coloring.size();
+  auto&& shardNodes = shards.nodes;
+  ShardedColoringResult result;
+
+  // the colors of the boundary nodes sent by the workers
+  std::vector<size_t> changed;
+  auto receiveChanged = [&](unsigned w) {
+    auto reply = pool[w].receive();
+    if (reply.size() % 2 != 0) {
+      throw std::runtime_error("A coloring worker sent a wrong reply.");
+    }
+    for (size_t i = 0; i < reply.size(); i += 2) {
+      size_t node = shardNodes[w].at(reply[i]);
+      coloring.color(node) = reply[i + 1];
+      changed.push_back(node);
+    }
+  };
+  for (unsigned w = 0; w < workers; ++w) {
+    receiveChanged(w);
+  }
+  result.boundaryNodes = changed.size();
+
+  std::vector<size_t> message;
+  while (true) {
+    message.assign(1, ROUND);
+    message.push_back(changed.size());
+    for (auto node : changed) {
+      message.push_back(node);
+      message.push_back(coloring.color(node));
+    }
+    for (unsigned w = 0; w < workers; ++w) {
+      pool[w].send(message);
+    }
+    changed.clear();
+    for (unsigned w = 0; w < workers; ++w) {
+      receiveChanged(w);
+    }
+    if (changed.empty()) {
+      break;
+    }
+    ++result.rounds;
+    result.recolored += changed.size();
+  }
+
+  // collect the colors of all nodes
+  for (unsigned w = 0; w < workers; ++w) {
+    pool[w].send({FINISH});
+  }
+  for (unsigned w = 0; w < workers; ++w) {
+    auto colors = pool[w].receive();
+    if (colors.size() != shardNodes[w].size()) {
+      throw std::runtime_error("A coloring worker sent a wrong reply.");
+    }
+    for (size_t i = 0; i < colors.size(); ++i) {
+      coloring.color(shardNodes[w][i]) = colors[i];
+    }
+  }
+  result.bytesSent = pool.bytesSent();
+  result.bytesReceived = pool.bytesReceived();
+  pool.join();
+
+  coloring.colorCount() = 0;
+  for (size_t i = 0; i < n; ++i) {
+    coloring.colorCount() = std::max(coloring.colorCount(), coloring.color(i));
+  }
+  return result;
+}
+
+}  // namespace
+
+ShardedColoringResult shardedColoring(const Graph& graph,
+                                      Coloring& coloring,
+                                      unsigned workers,
+                                      ShardPartition partition) {
+  if (workers == 0) {
+    workers = defaultThreadCount();
+  }
+  coloring.clear();
+  if (graph.size() == 0) {
+    return {};
+  }
+
+  auto owner = partitionGraph(graph, workers, partition);
+  Shards shards(owner, workers);
+  WorkerPool pool(workers, nullptr);
+  std::vector<size_t> message;
+  for (unsigned w = 0; w < workers; ++w) {
+    message.assign(1, shards.nodes[w].size());
+    for (auto node : shards.nodes[w]) {
+      message.push_back(node);
+      size_t count = message.size();
+      message.push_back(0);
+      for (auto neighbor : graph.neighbors(node)) {
+        if (owner[neighbor] == w) {
+          message.push_back(shards.local[neighbor]);
+        }
+      }
+      message[count] = message.size() - count - 1;
+      count = message.size();
+      message.push_back(0);
+      for (auto neighbor : graph.neighbors(node)) {
+        if (owner[neighbor] != w) {
+          message.push_back(neighbor);
+        }
+      }
+      message[count] = message.size() - count - 1;
+    }
+    pool[w].send(message);
+  }
+  return coordinate(shards, pool, coloring);
+}
+
+ShardedColoringResult shardedColoring(const std::string& snapshot,
+                                      Coloring& coloring,
+                                      unsigned workers) {
+  if (workers == 0) {
+    workers = defaultThreadCount();
+  }
+  // forked before the mapping, so no worker inherits it
+  WorkerPool pool(workers, &snapshot);
+  std::vector<unsigned> owner;
+  {
+    // the ranges are weighed by the offsets only
+    Graph graph = loadSnapshot(snapshot, false);
+    if (coloring.size() != graph.size()) {
+      throw std::invalid_argument("Coloring does not match the graph.");
+    }
+    owner = partitionGraph(graph, workers, ShardPartition::RANGES);
+  }
+  coloring.clear();
+  if (owner.empty()) {
+    return {};
+  }
+  Shards shards(owner, workers);
+  for (unsigned w = 0; w < workers; ++w) {
+    auto&& nodes = shards.nodes[w];
+    size_t begin = nodes.empty() ? 0 : nodes.front();
+    pool[w].send({begin, begin + nodes.size()});
+  }
+  return coordinate(shards, pool, coloring);
+}
+
+/*** End of file: sharded_coloring.cpp ***/
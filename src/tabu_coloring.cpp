@@ -0,0 +1,228 @@
+/**
+ * Project: gal
+ * @file tabu_coloring.cpp
+ * @date 17. 10. 2026
+ * @author xvitra00, xdocek09
+ * @brief Source file of module containing the tabucol local search.
+ */
+
+#include "tabu_coloring.h"
+
+#include <algorithm>
+#include <cstdint>
+#include <stdexcept>
+#include <vector>
+
+#include <random.h>
+#include "coloring_alg.h"
+
+namespace {
+
+using Clock = std::chrono::steady_clock;
+
+// moves between two looks at the clock
+constexpr size_t CLOCK_INTERVAL = 1024;
+// the random part of the tabu tenure
+constexpr size_t TENURE_RANDOM = 10;
+
+constexpr size_t NOT_CONFLICTING = static_cast<size_t>(-1);
+
+/**
+ * Set of the conflicting nodes with O(1) insertion, removal and random
+ * access.
+ */
+class NodeSet {
+ public:
+  explicit NodeSet(size_t nodeCount) : position_(nodeCount, NOT_CONFLICTING) {}
+
+  void insert(size_t node) {
+    if (position_[node] == NOT_CONFLICTING) {
+      position_[node] = nodes_.size();
+      nodes_.push_back(node);
+    }
+  }
+
+  void erase(size_t node) {
+    size_t position = position_[node];
+    if (position != NOT_CONFLICTING) {
+      position_[nodes_.back()] = position;
+      nodes_[position] = nodes_.back();
+      nodes_.pop_back();
+      position_[node] = NOT_CONFLICTING;
+    }
+  }
+
+  size_t size() const noexcept { return nodes_.size(); }
+  bool empty() const noexcept { return nodes_.empty(); }
+  size_t operator[](size_t i) const noexcept { return nodes_[i]; }
+
+ private:
+  std::vector<size_t> nodes_;
+  std::vector<size_t> position_;
+};
+
+}  // namespace
+
+TabucolResult tabucol(const Graph& graph,
+                      Coloring& coloring,
+                      size_t k,
+                      size_t maxMoves,
+                      Clock::duration timeLimit) {
+  const size_t n = graph.size();
+  TabucolResult result;
+  if (n == 0) {
+    result.success = true;
+    coloring.colorCount() = 0;
+    return result;
+  }
+  if (k == 0) {
+    throw std::invalid_argument("Tabucol needs at least one color.");
+  }
+  auto&& random = gal_thread_random();
+
+  // colors are 0 ... k - 1 here
+  std::vector<size_t> color(n);
+  for (size_t i = 0; i < n; ++i) {
+    size_t original = coloring.color(i);
+    color[i] = original != Coloring::NO_COLOR && original <= k
+                   ? original - Coloring::FIRST_COLOR
+                   : random.uniform(k);
+  }
+  // gamma[v * k + c]: the number of neighbors of v with color c
+  std::vector<uint32_t> gamma(n * k, 0);
+  NodeSet conflicting(n);
+  size_t conflicts = 0;
+  for (size_t i = 0; i < n; ++i) {
+    uint32_t* row = gamma.data() + i * k;
+    for (auto neighbor : graph.neighbors(i)) {
+      ++row[color[neighbor]];
+    }
+    if (row[color[i]] != 0) {
+      conflicting.insert(i);
+      conflicts += row[color[i]];
+    }
+  }
+  conflicts /= 2;
+  // tabu[v * k + c]: the first move at which v may take c again
+  std::vector<size_t> tabu(n * k, 0);
+  size_t bestConflicts = conflicts;
+
+  const auto start = Clock::now();
+  size_t move = 0;
+  for (; conflicts != 0 && move < maxMoves; ++move) {
+    if (move % CLOCK_INTERVAL == 0 && Clock::now() - start >= timeLimit) {
+      break;
+    }
+
+    // the best move of a conflicting node, ties are chosen uniformly
+    size_t bestNode = n;
+    size_t bestColor = 0;
+    long bestDelta = 0;
+    size_t ties = 0;
+    for (size_t i = 0; i < conflicting.size(); ++i) {
+      size_t node = conflicting[i];
+      const uint32_t* row = gamma.data() + node * k;
+      const size_t* tabuRow = tabu.data() + node * k;
+      const long current = row[color[node]];
+      for (size_t c = 0; c < k; ++c) {
+        if (c == color[node]) {
+          continue;
+        }
+        long delta = static_cast<long>(row[c]) - current;
+        bool aspiration = static_cast<long>(conflicts) + delta <
+                          static_cast<long>(bestConflicts);
+        if (tabuRow[c] > move && !aspiration) {
+          continue;
+        }
+        if (bestNode == n || delta < bestDelta) {
+          bestNode = node;
+          bestColor = c;
+          bestDelta = delta;
+          ties = 1;
+        } else if (delta == bestDelta && random.uniform(++ties) == 0) {
+          bestNode = node;
+          bestColor = c;
+        }
+      }
+    }
+    if (bestNode == n) {
+      if (k == 1) {
+        // no moves at all
+        break;
+      }
+      // everything is tabu, take a random move
+      bestNode = conflicting[random.uniform(conflicting.size())];
+      bestColor = (color[bestNode] + 1 + random.uniform(k - 1)) % k;
+      bestDelta = static_cast<long>(gamma[bestNode * k + bestColor]) -
+                  static_cast<long>(gamma[bestNode * k + color[bestNode]]);
+    }
+
+    // apply the move, only the rows of the neighbors change
+    const size_t oldColor = color[bestNode];
+    color[bestNode] = bestColor;
+    for (auto neighbor : graph.neighbors(bestNode)) {
+      uint32_t* row = gamma.data() + neighbor * k;
+      --row[oldColor];
+      ++row[bestColor];
+      if (color[neighbor] == oldColor && row[oldColor] == 0) {
+        conflicting.erase(neighbor);
+      } else if (color[neighbor] == bestColor && row[bestColor] == 1) {
+        conflicting.insert(neighbor);
+      }
+    }
+    if (gamma[bestNode * k + bestColor] == 0) {
+      conflicting.erase(bestNode);
+    }
+    conflicts += bestDelta;
+    bestConflicts = std::min(bestConflicts, conflicts);
+    tabu[bestNode * k + oldColor] = move + 1 + random.uniform(TENURE_RANDOM) +
+                                    conflicting.size() * 6 / 10;
+  }
+
+  result.seconds = std::chrono::duration<double>(Clock::now() - start).count();
+  result.moves = move;
+  result.movesPerSecond = result.seconds > 0 ? move / result.seconds : 0.0;
+  result.conflicts = bestConflicts;
+  result.success = conflicts == 0;
+  if (result.success) {
+    coloring.colorCount() = 0;
+    for (size_t i = 0; i < n; ++i) {
+      coloring.color(i) = color[i] + Coloring::FIRST_COLOR;
+      coloring.colorCount() =
+          std::max(coloring.colorCount(), coloring.color(i));
+    }
+  }
+  return result;
+}
+
+TabucolResult tabucolColoring(const Graph& graph,
+                              Coloring& coloring,
+                              size_t maxMoves,
+                              Clock::duration timeLimit) {
+  const auto start = Clock::now();
+  sdoLdoColoring(graph, coloring);
+  TabucolResult total;
+  total.success = true;
+  while (coloring.colorCount() > 1 && total.moves < maxMoves) {
+    auto elapsed = Clock::now() - start;
+    if (elapsed >= timeLimit) {
+      break;
+    }
+    auto run = tabucol(graph,
+                       coloring,
+                       coloring.colorCount() - 1,
+                       maxMoves - total.moves,
+                       timeLimit - elapsed);
+    total.success = run.success;
+    total.conflicts = run.conflicts;
+    total.moves += run.moves;
+    total.seconds += run.seconds;
+    if (!run.success) {
+      break;
+    }
+  }
+  total.movesPerSecond = total.seconds > 0 ? total.moves / total.seconds : 0.0;
+  return total;
+}
+
+/*** End of file: tabu_coloring.cpp ***/
@@ -0,0 +1,142 @@
+/**
+ * Project: gal
+ * @file trace.cpp
+ * @date 17. 10. 2026
+ * @author xvitra00, xdocek09
+ * @brief Source file of module recording timed spans of program phases.
+ */
+
+#include "trace.h"
+
+#include <chrono>
+#include <memory>
+#include <mutex>
+#include <vector>
+
+namespace {
+
+struct TraceEvent {
+  const char* name;
+  uint64_t start;
+  uint64_t end;
+};
+
+/**
+ * Ring buffer of one thread. It grows up to TRACE_RING_EVENTS events and
+ * then overwrites the oldest ones.
+ */
+struct ThreadTrace {
+  size_t thread;
+  std::vector<TraceEvent> events;
+  size_t next = 0;
+  bool used = true;
+};
+
+const auto processStart = std::chrono::steady_clock::now();
+
+std::mutex registryMutex;
+// buffers outlive their threads, the worker threads are short-lived
+std::vector<std::unique_ptr<ThreadTrace>> registry;
+
+/**
+ * Hands the buffer of an ended thread to the next new thread, so the workers
+ * of the parallel loops share a few tracks instead of one each.
+ */
+struct ThreadTraceOwner {
+  ThreadTrace* trace = nullptr;
+
+  ~ThreadTraceOwner() {
+    if (trace != nullptr) {
+      std::lock_guard<std::mutex> lock(registryMutex);
+      trace->used = false;
+    }
+  }
+};
+
+ThreadTrace& threadTrace() {
+  thread_local ThreadTraceOwner owner;
+  if (owner.trace == nullptr) {
+    std::lock_guard<std::mutex> lock(registryMutex);
+    for (auto&& trace : registry) {
+      if (!trace->used) {
+        trace->used = true;
+        owner.trace = trace.get();
+        return *owner.trace;
+      }
+    }
+    registry.push_back(std::make_unique<ThreadTrace>());
+    owner.trace = registry.back().get();
+    owner.trace->thread = registry.size();
+  }
+  return *owner.trace;
+}
+
+void writeEscaped(std::ostream& os, const char* s) {
+  for (; *s != '\0'; ++s) {
+    if (*s == '"' || *s == '\\') {
+      os << '\\';
+    }
+    os << *s;
+  }
+}
+
+/**
+ * Writes nanoseconds as microseconds, the unit of the trace format.
+ */
+void writeMicroseconds(std::ostream& os, uint64_t ns) {
+  const uint64_t fraction = ns % 1000;
+  os << ns / 1000 << '.' << fraction / 100 << fraction / 10 % 10
+     << fraction % 10;
+}
+
+}  // namespace
+
+uint64_t Tracer::now() noexcept {
+  return std::chrono::duration_cast<std::chrono::nanoseconds>(
+             std::chrono::steady_clock::now() - processStart)
+      .count();
+}
+
+void Tracer::record(const char* name, uint64_t start, uint64_t end) noexcept {
+  try {
+    auto&& trace = threadTrace();
+    if (trace.events.size() < TRACE_RING_EVENTS) {
+      trace.events.push_back({name, start, end});
+    } else {
+      trace.events[trace.next] = {name, start, end};
+      trace.next = (trace.next + 1) % TRACE_RING_EVENTS;
+    }
+  } catch (...) {
+    // a lost span is better than a lost run
+  }
+}
+
+void Tracer::writeChromeTrace(std::ostream& os) {
+  std::lock_guard<std::mutex> lock(registryMutex);
+  os << "{\"displayTimeUnit\": \"ms\", \"traceEvents\": [";
+  bool first = true;
+  for (auto&& trace : registry) {
+    os << (first ? "\n" : ",\n") << "{\"name\": \"thread_name\", \"ph\": \"M\""
+       << ", \"pid\": 1, \"tid\": " << trace->thread
+       << ", \"args\": {\"name\": \""
+       << (trace->thread == 1 ? "main" : "worker") << ' ' << trace->thread
+       << "\"}}";
+    first = false;
+    // the oldest event first
+    const size_t count = trace->events.size();
+    for (size_t i = 0; i < count; ++i) {
+      auto&& event = trace->events[(trace->next + i) % count];
+      os << ",\n{\"name\": \"";
+      writeEscaped(os, event.name);
+      os << "\", \"ph\": \"X\", \"pid\": 1, \"tid\": " << trace->thread
+         << ", \"ts\": ";
+      writeMicroseconds(os, event.start);
+      os << ", \"dur\": ";
+      writeMicroseconds(os, event.end - event.start);
+      os << '}';
+    }
+  }
+  os << "\n]}\n";
+}
+
+/*** End of file: trace.cpp ***/